@@ -9,6 +9,7 @@
  *   - Converting grid coordinates to pixel coordinates
  *   - Drawing vertical & horizontal grid lines
  *   - Handling the basic SDL event loop
+ *   - Caching static drawing (background + grid lines) in a texture
  *   - Using variables to control cell size, grid width, and height
  *
  */
@@ -178,6 +179,67 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // ------------------------------------------------------------
+    // BACKGROUND LAYER
+    // ------------------------------------------------------------
+    // The background and the grid lines never change, so they are
+    // drawn ONCE into a texture that the renderer can draw into
+    // (SDL_TEXTUREACCESS_TARGET). Each frame then copies that one
+    // texture instead of calling SDL_RenderDrawLine for every line.
+    // If the renderer cannot draw into textures, gridLayer stays
+    // nullptr and the lines are drawn every frame as before. Some
+    // drivers drop texture contents (SDL_RENDER_TARGETS_RESET) or
+    // the whole device (SDL_RENDER_DEVICE_RESET); the main loop then
+    // builds the layer again.
+    auto drawBackground = [&]() {
+        // Set the background color first (dark blue-gray here).
+        // The format is RGBA, each component 0–255.
+        SDL_SetRenderDrawColor(renderer, 30, 30, 40, 255);
+        SDL_RenderClear(renderer);
+
+        // Set the color for the grid lines (lighter gray).
+        SDL_SetRenderDrawColor(renderer, 80, 80, 100, 255);
+
+        // Draw vertical lines.
+        // Start at x = 0 and go to windowWidth, stepping by cellSize each time.
+        for (int x = 0; x <= windowWidth; x += cellSize) {
+            SDL_RenderDrawLine(renderer, x, 0, x, windowHeight);
+        }
+
+        // Draw horizontal lines.
+        // Start at y = 0 and go to windowHeight, stepping by cellSize each time.
+        for (int y = 0; y <= windowHeight; y += cellSize) {
+            SDL_RenderDrawLine(renderer, 0, y, windowWidth, y);
+        }
+    };
+
+    SDL_Texture* gridLayer = nullptr;
+    auto buildGridLayer    = [&]() {
+        if (gridLayer)
+            SDL_DestroyTexture(gridLayer);
+        gridLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, windowWidth,
+                                      windowHeight);
+        if (gridLayer && SDL_SetRenderTarget(renderer, gridLayer) == 0) {
+            drawBackground();                    // into the texture...
+            SDL_SetRenderTarget(renderer, NULL);  // ...then back to the window
+        } else if (gridLayer) {
+            SDL_DestroyTexture(gridLayer);
+            gridLayer = nullptr;
+        }
+    };
+    buildGridLayer();
+
+    // ------------------------------------------------------------
+    // SHAPE COLOR
+    // ------------------------------------------------------------
+    // Seed the random number generator ONCE and pick the shape's
+    // color. (Seeding every frame restarts the same sequence, and
+    // costs a time() call per frame for nothing.)
+    srand(time(0));
+    int r = rand() % 256;
+    int g = rand() % 256;
+    int b = rand() % 256;
+
     // ------------------------------------------------------------
     // MAIN LOOP
     // ------------------------------------------------------------
@@ -198,40 +260,23 @@ int main(int argc, char* argv[]) {
             // Check for ESC key press
             if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)
                 running = false;         // Exit when ESC is pressed
-        }
 
-        // --------------------------------------------------------
-        // CLEAR SCREEN
-        // --------------------------------------------------------
-        // Set the background color first (dark blue-gray here).
-        // The format is RGBA, each component 0–255.
-        SDL_SetRenderDrawColor(renderer, 30, 30, 40, 255);
-        SDL_RenderClear(renderer);
+            // The driver lost the background texture's contents.
+            if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+                buildGridLayer();
+        }
 
         // --------------------------------------------------------
-        // DRAW GRID LINES
+        // BACKGROUND + GRID LINES
         // --------------------------------------------------------
-        // Set the color for the grid lines (lighter gray).
-        SDL_SetRenderDrawColor(renderer, 80, 80, 100, 255);
+        // One texture copy (or the full redraw if there is no
+        // texture). Everything drawn after this lands on top.
+        if (gridLayer)
+            SDL_RenderCopy(renderer, gridLayer, NULL, NULL);
+        else
+            drawBackground();
 
-        // Draw vertical lines.
-        // Start at x = 0 and go to windowWidth, stepping by cellSize each time.
-        for (int x = 0; x <= windowWidth; x += cellSize) {
-            SDL_RenderDrawLine(renderer, x, 0, x, windowHeight);
-        }
-
-        // Draw horizontal lines.
-        // Start at y = 0 and go to windowHeight, stepping by cellSize each time.
-        for (int y = 0; y <= windowHeight; y += cellSize) {
-            SDL_RenderDrawLine(renderer, 0, y, windowWidth, y);
-        }
-
-        
         // Sets color for the shapes
-        srand(time(0));
-        int r = rand() % 256;
-        int g = rand() % 256;
-        int b = rand() % 256;
         SDL_SetRenderDrawColor(renderer, r, g, b, 255);
         
         // Draw each cell from the selected shape
@@ -265,6 +310,8 @@ int main(int argc, char* argv[]) {
     // CLEANUP
     // ------------------------------------------------------------
     // Free SDL resources before exiting to avoid memory leaks.
+    if (gridLayer)
+        SDL_DestroyTexture(gridLayer);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
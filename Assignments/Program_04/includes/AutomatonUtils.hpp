@@ -29,4 +29,43 @@ inline int wrapIndex(int value, int max) {
     int result = value % max;         // may be negative in C++
     return result < 0 ? result + max  // fix negative remainder
                       : result;       // already in range
-}
\ No newline at end of file
+}
+
+// --------------------------------------------------------------
+// Function: rasterizeLine
+// Purpose : Visit every grid cell on the straight line from
+//           (r0, c0) to (r1, c1), both ends included, using
+//           Bresenham's integer algorithm.
+//
+// Why it's needed:
+//   A fast mouse drag only reports a few positions per frame.
+//   Painting just those cells leaves gaps; joining consecutive
+//   positions with a line gives a continuous stroke.
+//
+// Example:
+//   rasterizeLine(0, 0, 2, 4, f) calls f at
+//   (0,0) (0,1) (1,2) (1,3) (2,4)
+// --------------------------------------------------------------
+template <typename Visit>
+void rasterizeLine(int r0, int c0, int r1, int c1, Visit visit) {
+    int dr = r1 > r0 ? r1 - r0 : r0 - r1;
+    int dc = c1 > c0 ? c1 - c0 : c0 - c1;
+    int sr = r0 < r1 ? 1 : -1;
+    int sc = c0 < c1 ? 1 : -1;
+    int err = dc - dr;  // error term tracks distance from the ideal line
+
+    while (true) {
+        visit(r0, c0);
+        if (r0 == r1 && c0 == c1)
+            break;
+        int e2 = 2 * err;
+        if (e2 > -dr) {
+            err -= dr;
+            c0 += sc;
+        }
+        if (e2 < dc) {
+            err += dc;
+            r0 += sr;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GridView.hpp"
+#include "HugePages.hpp"
+#include "LifeRule.hpp"
+
+// --------------------------------------------------------------
+// BitBoard:
+// --------------------------------------------------------------
+// A bit-packed Life board: one bit per cell, 64 cells per word,
+// rows padded to whole words. One step() updates 64 cells at a time
+// with a bit-sliced adder, so it is far faster than stepping the
+// nested-vector grid one cell at a time.
+//
+// Cells outside the board are dead (no wrap-around), matching
+// CellularAutomaton::countNeighbors(). Internally there is one
+// all-zero row above and below the board so the kernel needs no
+// edge checks.
+//
+// Used for fast-forwarding: load() a grid, step() many times,
+// store() the result back. view() hands the packed rows to screens
+// and recorders as they are. Both generations share one HugePages
+// block (DoubleBuffer).
+//
+// A board with no rows or no columns is allowed (it never has live
+// cells); a negative size throws std::invalid_argument.
+// --------------------------------------------------------------
+class BitBoard {
+   public:
+    BitBoard(int rows, int cols);
+
+    void load(const GridView& grid);
+    void store(std::vector<std::vector<int>>& grid) const;
+
+    // Advance one generation under 'rule'.
+    void step(const LifeRule& rule);
+
+    long population() const;
+    uint64_t hash() const;  // 64-bit hash of the live cells
+    bool operator==(const BitBoard& other) const { return cells == other.cells; }
+
+    int rowCount() const { return rows; }
+    int colCount() const { return cols; }
+    int wordsPerRow() const { return words; }
+
+    GridView view() const { return GridView::bits(row(0), rows, cols, words); }
+
+    // Packed row r (0-based), words() words long.
+    const uint64_t* row(int r) const { return cells.cur() + (size_t)(r + 1) * words; }
+    uint64_t* row(int r) { return cells.cur() + (size_t)(r + 1) * words; }
+
+   private:
+    int rows, cols, words;
+    uint64_t tailMask;           // valid bits of the last word in a row
+    DoubleBuffer<uint64_t> cells;  // (rows + 2) * words each, padding rows zero
+};
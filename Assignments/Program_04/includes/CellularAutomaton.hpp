@@ -1,7 +1,27 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
+#include "GridView.hpp"
+#include "Symmetry.hpp"
+
+// --------------------------------------------------------------
+// Running statistics kept up to date by step() and the cell
+// mutators, so callers (HUD, control socket, tests) can read them
+// without rescanning the grid.
+// --------------------------------------------------------------
+struct AutomatonStats {
+    uint64_t generation = 0;  // generations stepped so far
+    long population     = 0;  // live cells right now
+    long births         = 0;  // cells born in the last step
+    long deaths         = 0;  // cells that died in the last step
+};
+
 // --------------------------------------------------------------
 // Base class for 2D Cellular Automata.
 // This provides the grid structure and general utilities,
@@ -23,13 +43,102 @@ class CellularAutomaton {
     // Many automata use 0 = dead, 1 = alive, but derived classes may extend this.
     std::vector<std::vector<int>> grid;
 
+    // Maintained incrementally; see AutomatonStats.
+    AutomatonStats counters;
+
+    // One flag per TILE x TILE block, set whenever a cell in the block
+    // is edited from outside step(). Renderers and analyzers can use
+    // it to revisit only what changed; whoever consumes it clears it.
+    std::vector<uint8_t> dirty;
+    int tileCols;
+
+    // Optional heatmap companions, rows*cols each, row-major. Only
+    // allocated while enableHeatmap(true) is in effect.
+    bool heatmapOn = false;
+    std::vector<uint8_t> age;       // generations alive in a row, saturating at 255
+    std::vector<uint8_t> activity;  // recent state changes, decaying by 1/8 per step
+
+    // Amount added to activity when a cell changes state.
+    static constexpr int ACTIVITY_BUMP = 64;
+
+    // ----------------------------------------------------------
+    // updateHeatmapRow(): called by step() for row i right after the
+    // row's new states are computed, while both rows are in cache.
+    // ----------------------------------------------------------
+    void updateHeatmapRow(int i, const std::vector<int>& before, const std::vector<int>& after) {
+        heatmapKernel(&age[(size_t)i * cols], &activity[(size_t)i * cols], before.data(), after.data(), cols);
+    }
+
+    // ----------------------------------------------------------
+    // heatmapKernel(): 16 cells per iteration with GCC/Clang vector
+    // extensions (SSE2/NEON or wider, whatever the target has), then
+    // the same arithmetic one cell at a time for the tail. Plain
+    // loops are not auto-vectorized at -O2 because the int states
+    // have to be narrowed to bytes.
+    //
+    //   age      = alive ? min(age + 1, 255) : 0
+    //   activity = min(activity - activity/8 + (changed ? BUMP : 0), 255)
+    // ----------------------------------------------------------
+    static void heatmapKernel(uint8_t* a, uint8_t* h, const int* was, const int* is, int n) {
+        typedef int32_t Ints __attribute__((vector_size(64)));
+        typedef int8_t Mask __attribute__((vector_size(16)));
+        typedef uint8_t Bytes __attribute__((vector_size(16)));
+
+        int j = 0;
+        for (; j + 16 <= n; j += 16) {
+            Ints now, before;
+            Bytes ages, heat;
+            std::memcpy(&now, is + j, sizeof now);
+            std::memcpy(&before, was + j, sizeof before);
+            std::memcpy(&ages, a + j, sizeof ages);
+            std::memcpy(&heat, h + j, sizeof heat);
+
+            Bytes alive   = (Bytes)__builtin_convertvector(now != 0, Mask);  // 0xFF / 0x00
+            Bytes changed = alive ^ (Bytes)__builtin_convertvector(before != 0, Mask);
+
+            ages = (ages + ((Bytes)(ages != 255) & 1)) & alive;
+
+            Bytes decayed = heat - (heat >> 3);
+            Bytes sum     = decayed + (changed & ACTIVITY_BUMP);
+            heat          = sum | (Bytes)(sum < decayed);  // saturate on wrap-around
+
+            std::memcpy(a + j, &ages, sizeof ages);
+            std::memcpy(h + j, &heat, sizeof heat);
+        }
+        for (; j < n; ++j) {
+            unsigned alive   = is[j] != 0;
+            unsigned changed = alive ^ (was[j] != 0);
+            unsigned heat    = h[j] - (h[j] >> 3) + changed * ACTIVITY_BUMP;
+            a[j]             = (uint8_t)(alive * (a[j] + (a[j] != 255)));
+            h[j]             = (uint8_t)std::min(heat, 255u);
+        }
+    }
+
+    // Forget the history: live cells count as age 1, no activity.
+    // Used whenever the board is replaced rather than stepped.
+    void resetHeatmap() {
+        if (!heatmapOn)
+            return;
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < cols; ++c) age[(size_t)r * cols + c] = grid[r][c] != 0;
+        std::fill(activity.begin(), activity.end(), 0);
+    }
+
    public:
     // ----------------------------------------------------------
     // Constructor initializes grid size and sets all cells to 0.
     // ----------------------------------------------------------
-    CellularAutomaton(int r, int c) : rows(r), cols(c), grid(r, std::vector<int>(c, 0)) {
+    CellularAutomaton(int r, int c)
+        : rows(r),
+          cols(c),
+          grid(r, std::vector<int>(c, 0)),
+          dirty((size_t)((r + TILE - 1) / TILE) * ((c + TILE - 1) / TILE), 0),
+          tileCols((c + TILE - 1) / TILE) {
     }
 
+    // Edge length of a dirty-tracking tile, in cells.
+    static constexpr int TILE = 32;
+
     // Virtual destructor for safe polymorphic deletion.
     virtual ~CellularAutomaton() = default;
 
@@ -39,12 +148,39 @@ class CellularAutomaton {
     // ----------------------------------------------------------
     virtual void step() = 0;
 
+    // ----------------------------------------------------------
+    // advance(n, progress): step 'n' generations as fast as the
+    // engine can, with no rendering in between.
+    //
+    // 'progress(done)' is called every so often; returning false
+    // cancels. Returns the number of generations actually advanced.
+    //
+    // This default just calls step() in a loop; engines override it
+    // with something faster (see ConwayLife).
+    // ----------------------------------------------------------
+    virtual uint64_t advance(uint64_t n, const std::function<bool(uint64_t)>& progress = nullptr) {
+        for (uint64_t done = 0; done < n; ++done) {
+            if (progress && done % 1024 == 0 && done > 0 && !progress(done))
+                return done;
+            step();
+        }
+        return n;
+    }
+
     // ----------------------------------------------------------
     // display(): Print or visualize the automaton.
     // Pure virtual → derived classes MUST implement this.
     // ----------------------------------------------------------
     virtual void display() const = 0;
 
+    // ----------------------------------------------------------
+    // nextState(state, neighbors): the local rule on its own.
+    // Pure virtual → derived classes MUST implement this. Lets
+    // generic code (e.g. simulateRegion) evolve cells without
+    // going through step(), which always updates the whole board.
+    // ----------------------------------------------------------
+    virtual int nextState(int state, int neighbors) const = 0;
+
     // ----------------------------------------------------------
     // countNeighbors:
     // Counts all orthogonal + diagonal neighbors around (r, c)
@@ -81,12 +217,255 @@ class CellularAutomaton {
     // Example: density = 0.20 → 20% chance of being alive.
     // ----------------------------------------------------------
     void randomize(double density) {
+        counters.population = 0;
         for (int r = 0; r < rows; r++) {
             for (int c = 0; c < cols; c++) {
                 double x   = (double)rand() / RAND_MAX;
                 grid[r][c] = (x < density) ? 1 : 0;
+                counters.population += grid[r][c];
+            }
+        }
+        std::fill(dirty.begin(), dirty.end(), 1);
+        resetHeatmap();
+    }
+
+    // ----------------------------------------------------------
+    // randomizeSymmetric(density, symmetry):
+    // Like randomize(), but the soup has the given symmetry (see
+    // Symmetry.hpp). Each orbit of cells gets ONE random draw, made
+    // by its first cell in row-major order; the rest copy it.
+    // ----------------------------------------------------------
+    void randomizeSymmetric(double density, Symmetry symmetry) {
+        checkSymmetry(symmetry, rows, cols);
+        counters.population = 0;
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                std::pair<int, int> first{r, c};
+                for (auto img : symmetryImages(symmetry, rows, cols, r, c)) first = std::min(first, img);
+
+                if (first == std::make_pair(r, c)) {
+                    double x   = (double)rand() / RAND_MAX;
+                    grid[r][c] = (x < density) ? 1 : 0;
+                } else {
+                    grid[r][c] = grid[first.first][first.second];
+                }
+                counters.population += grid[r][c];
             }
         }
+        std::fill(dirty.begin(), dirty.end(), 1);
+        resetHeatmap();
+    }
+
+    // ----------------------------------------------------------
+    // setCell / toggleCell / clear:
+    // The only ways to edit cells from outside. Out-of-range
+    // coordinates are ignored, which makes it safe to stamp
+    // patterns partially off the board.
+    // ----------------------------------------------------------
+    void setCell(int r, int c, int value) {
+        if (r < 0 || r >= rows || c < 0 || c >= cols)
+            return;
+        counters.population += (value != 0) - (grid[r][c] != 0);
+        if (heatmapOn && (value != 0) != (grid[r][c] != 0)) {
+            size_t k    = (size_t)r * cols + c;
+            age[k]      = value != 0;
+            activity[k] = (uint8_t)std::min(activity[k] + ACTIVITY_BUMP, 255);
+        }
+        grid[r][c] = value;
+        dirty[(size_t)(r / TILE) * tileCols + c / TILE] = 1;
+    }
+
+    void toggleCell(int r, int c) {
+        if (r >= 0 && r < rows && c >= 0 && c < cols)
+            setCell(r, c, grid[r][c] ? 0 : 1);
+    }
+
+    void clear() {
+        for (auto& row : grid) std::fill(row.begin(), row.end(), 0);
+        counters.population = 0;
+        std::fill(dirty.begin(), dirty.end(), 1);
+        resetHeatmap();
+    }
+
+    // ----------------------------------------------------------
+    // Dirty tiles: tile (tr, tc) covers rows [tr*TILE, tr*TILE+TILE)
+    // and columns [tc*TILE, tc*TILE+TILE).
+    // ----------------------------------------------------------
+    bool isTileDirty(int tr, int tc) const {
+        return dirty[(size_t)tr * tileCols + tc] != 0;
+    }
+    bool anyDirty() const {
+        return std::find(dirty.begin(), dirty.end(), 1) != dirty.end();
+    }
+    void clearDirty() {
+        std::fill(dirty.begin(), dirty.end(), 0);
+    }
+
+    // ----------------------------------------------------------
+    // restore(): replace the whole board, e.g. when rewinding to a
+    // state from History. Recomputes population and marks every
+    // tile dirty. 'state' must have the same dimensions.
+    // ----------------------------------------------------------
+    void restore(const std::vector<std::vector<int>>& state, uint64_t generation) {
+        if ((int)state.size() != rows || (rows > 0 && (int)state[0].size() != cols)) {
+            throw std::invalid_argument("restore(): board size mismatch");
+        }
+        grid                = state;
+        counters.generation = generation;
+        counters.population = 0;
+        counters.births = counters.deaths = 0;
+        for (const auto& row : grid)
+            for (int cell : row) counters.population += cell != 0;
+        std::fill(dirty.begin(), dirty.end(), 1);
+        resetHeatmap();
+    }
+
+    // ----------------------------------------------------------
+    // resize(r, c): change the board size in place, e.g. when the
+    // window grows. Cells inside both sizes keep their state, new
+    // cells are dead, cells outside the new size are dropped.
+    //
+    // The existing board is never copied: new rows are appended
+    // (the outer vector moves rows, it does not copy them), and a
+    // row that gets wider grows within its own capacity, which is
+    // reserved generously (1.5x, whole tiles) so that a window being
+    // dragged larger reallocates each row only a few times. Tiles
+    // that gained or lost cells are marked dirty; the heatmap
+    // buffers, if enabled, are laid out again for the new width.
+    // ----------------------------------------------------------
+    void resize(int r, int c) {
+        if (r < 0 || c < 0) {
+            throw std::invalid_argument("resize(): negative board size");
+        }
+        if (r == rows && c == cols)
+            return;
+
+        // Whatever falls outside leaves the population.
+        for (int i = 0; i < rows; ++i)
+            for (int j = i < r ? std::min(c, cols) : 0; j < cols; ++j) counters.population -= grid[i][j] != 0;
+
+        auto reserveRow = [&](std::vector<int>& row) {
+            if ((size_t)c > row.capacity()) {
+                size_t want = std::max((size_t)c, row.capacity() + row.capacity() / 2);
+                row.reserve((want + TILE - 1) / TILE * TILE);
+            }
+            row.resize(c, 0);
+        };
+        if (r < rows)
+            grid.resize(r);
+        for (auto& row : grid) reserveRow(row);
+        while ((int)grid.size() < r) {
+            grid.emplace_back();
+            reserveRow(grid.back());
+        }
+
+        // Tiles entirely inside both sizes keep their flag.
+        int newTileCols = (c + TILE - 1) / TILE, newTileRows = (r + TILE - 1) / TILE;
+        std::vector<uint8_t> newDirty((size_t)newTileRows * newTileCols, 1);
+        for (int tr = 0; (tr + 1) * TILE <= std::min(r, rows); ++tr)
+            for (int tc = 0; (tc + 1) * TILE <= std::min(c, cols); ++tc)
+                newDirty[(size_t)tr * newTileCols + tc] = dirty[(size_t)tr * tileCols + tc];
+        dirty.swap(newDirty);
+        tileCols = newTileCols;
+
+        if (heatmapOn) {
+            std::vector<uint8_t> newAge((size_t)r * c, 0), newActivity((size_t)r * c, 0);
+            for (int i = 0; i < std::min(r, rows); ++i) {
+                size_t n = std::min(c, cols);
+                std::memcpy(&newAge[(size_t)i * c], &age[(size_t)i * cols], n);
+                std::memcpy(&newActivity[(size_t)i * c], &activity[(size_t)i * cols], n);
+            }
+            age.swap(newAge);
+            activity.swap(newActivity);
+        }
+
+        rows = r;
+        cols = c;
+    }
+
+    // ----------------------------------------------------------
+    // Heatmap: per-cell age and activity, kept up to date by step()
+    // of engines that support it (ConwayLife). Off by default, since
+    // it costs two bytes per cell and some step time. Fast-forward
+    // and whole-board replacements reset it.
+    // ----------------------------------------------------------
+    void enableHeatmap(bool on) {
+        heatmapOn = on;
+        if (on) {
+            age.assign((size_t)rows * cols, 0);
+            activity.assign((size_t)rows * cols, 0);
+            resetHeatmap();
+        } else {
+            age.clear();
+            age.shrink_to_fit();
+            activity.clear();
+            activity.shrink_to_fit();
+        }
+    }
+    bool heatmapEnabled() const { return heatmapOn; }
+    const std::vector<uint8_t>& getAge() const { return age; }
+    const std::vector<uint8_t>& getActivity() const { return activity; }
+
+    // The heatmap byte maps as views (0 x 0 while it is disabled).
+    GridView ageView() const { return GridView::bytes(age.data(), age.empty() ? 0 : rows, cols); }
+    GridView activityView() const { return GridView::bytes(activity.data(), activity.empty() ? 0 : rows, cols); }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    const AutomatonStats& getStats() const {
+        return counters;
+    }
+
+    // ----------------------------------------------------------
+    // simulateRegion(row0, col0, h, w, T):
+    // Returns what the h x w window at (row0, col0) will look like
+    // T generations from now, WITHOUT changing the board.
+    //
+    // Information travels at most one cell per generation, so only
+    // the window grown by T cells on each side can influence it.
+    // We copy that area and, each generation, update only the part
+    // that is still exact: it shrinks by one cell per side per
+    // generation (the "light cone"), except along the board's own
+    // edges, where the outside is known to be dead and nothing
+    // shrinks. Work is about (w+2T)(h+2T)T cells instead of
+    // rows*cols*T.
+    // ----------------------------------------------------------
+    std::vector<std::vector<int>> simulateRegion(int row0, int col0, int h, int w, int T) const {
+        // Known area at t = 0, clipped to the board.
+        int top = std::max(0, row0 - T), bottom = std::min(rows, row0 + h + T);
+        int left = std::max(0, col0 - T), right = std::min(cols, col0 + w + T);
+
+        // Local buffers with a one-cell dead border.
+        int bh = std::max(0, bottom - top) + 2, bw = std::max(0, right - left) + 2;
+        std::vector<std::vector<int>> cur(bh, std::vector<int>(bw, 0)), next = cur;
+        for (int r = top; r < bottom; ++r)
+            for (int c = left; c < right; ++c) cur[r - top + 1][c - left + 1] = grid[r][c];
+
+        for (int t = 1; t <= T; ++t) {
+            // Exact area at time t, in board coordinates.
+            int r0 = top == 0 ? 0 : top + t, r1 = bottom == rows ? rows : bottom - t;
+            int c0 = left == 0 ? 0 : left + t, c1 = right == cols ? cols : right - t;
+
+            for (int r = r0; r < r1; ++r) {
+                int i = r - top + 1;
+                for (int c = c0; c < c1; ++c) {
+                    int j = c - left + 1;
+                    int n = (cur[i - 1][j - 1] == 1) + (cur[i - 1][j] == 1) + (cur[i - 1][j + 1] == 1) +
+                            (cur[i][j - 1] == 1) + (cur[i][j + 1] == 1) + (cur[i + 1][j - 1] == 1) +
+                            (cur[i + 1][j] == 1) + (cur[i + 1][j + 1] == 1);
+                    next[i][j] = nextState(cur[i][j], n);
+                }
+            }
+            std::swap(cur, next);
+        }
+
+        // Cut the requested window out; off-board cells read as dead.
+        std::vector<std::vector<int>> out(h, std::vector<int>(w, 0));
+        for (int r = std::max(row0, top); r < std::min(row0 + h, bottom); ++r)
+            for (int c = std::max(col0, left); c < std::min(col0 + w, right); ++c)
+                out[r - row0][c - col0] = cur[r - top + 1][c - left + 1];
+        return out;
     }
 
     // ----------------------------------------------------------
@@ -96,4 +475,10 @@ class CellularAutomaton {
     const std::vector<std::vector<int>>& getGrid() const {
         return grid;
     }
+
+    // The same board as a GridView, for screens, recorders and
+    // analyzers (no copy; valid until the next step or resize).
+    GridView view() const {
+        return GridView(grid);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FateCache.hpp"
+#include "GridView.hpp"
+#include "LifeRule.hpp"
+
+// --------------------------------------------------------------
+// Census of a board's debris
+// --------------------------------------------------------------
+// The board is split into CLUSTERS: live cells are in the same
+// cluster when they are within 2 cells of each other (Chebyshev
+// distance), so separate clusters start at least two dead cells
+// apart. Each cluster is evolved on its own until it repeats, and
+// its settled objects are counted by name:
+//
+//   xs<pop>_<bitmap>  still life
+//   xp<p>_<bitmap>    oscillator of period p
+//   xq<p>_<bitmap>    spaceship of period p
+//
+// <bitmap> is the canonical form: "<rows>x<cols>_<hex>" of the
+// orientation (of the 8 rotations/reflections) that sorts first, so
+// a block is the same object wherever and however it appears.
+// Clusters that do not settle within the limits are counted as
+// "unsettled".
+//
+// Treating clusters as independent is exact for ash (settled soups),
+// which is what batch searches census. Fates are looked up in and
+// stored to an optional FateCache keyed by the canonical form, the
+// nesting depth and the limits (a fate depends on all three).
+// --------------------------------------------------------------
+
+// A small bitmap placed at (row0, col0) on the board.
+struct Cluster {
+    int row0 = 0, col0 = 0;
+    int rows = 0, cols = 0;
+    std::vector<uint8_t> cells;  // rows * cols, row-major
+
+    int at(int r, int c) const { return cells[(size_t)r * cols + c]; }
+    long population() const;
+};
+
+struct CensusLimits {
+    int maxGenerations = 4096;  // per cluster
+    int maxExtent      = 256;   // bounding box side before giving up
+};
+
+struct CensusResult {
+    std::map<std::string, long> objects;
+    long clusters  = 0;
+    long unsettled = 0;
+};
+
+// Split a board into clusters.
+std::vector<Cluster> findClusters(const GridView& grid);
+
+// Canonical key: the rule plus the first-sorting orientation.
+std::string canonicalKey(const Cluster& cluster, const LifeRule& rule);
+
+// Evolve one cluster in isolation (or fetch its fate from 'cache').
+ClusterFate clusterFate(const Cluster& cluster, const LifeRule& rule, FateCache* cache = nullptr,
+                        const CensusLimits& limits = CensusLimits());
+
+// Count the settled objects of every cluster on the board.
+CensusResult census(const GridView& grid, const LifeRule& rule, FateCache* cache = nullptr,
+                    const CensusLimits& limits = CensusLimits());
@@ -22,7 +22,16 @@ public:
     // Utility: did click occur inside a rect?
     bool inside(const SDL_Rect& r) const;
 
+    // Utility: pixel → grid coordinates for square cells of
+    // 'cellSize' pixels. Rounds toward -infinity, so a drag that
+    // leaves the window gives negative (off-grid) cells rather than
+    // folding back onto row/column 0.
+    int gridRow(int cellSize) const { return floorDiv(my, cellSize); }
+    int gridCol(int cellSize) const { return floorDiv(mx, cellSize); }
+
 private:
+    static int floorDiv(int a, int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+
     int mx = 0, my = 0;
     bool left_down = false;
     bool left_clicked = false;
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "CellularAutomaton.hpp"
+#include "LifeRule.hpp"
+#include "MpscQueue.hpp"
+
+// --------------------------------------------------------------
+// ControlCommand:
+// One request from the control socket, applied by the engine
+// between generations.
+// --------------------------------------------------------------
+struct ControlCommand {
+    enum Type { Pause, Resume, Step, SetRule, Stamp, Snapshot, Quit };
+
+    Type type     = Pause;
+    long count    = 0;  // Step: number of generations
+    int row       = 0;  // Stamp: anchor cell
+    int col       = 0;
+    LifeRule rule;      // SetRule
+    std::string text;   // Stamp: pattern name, Snapshot: file path
+};
+
+// --------------------------------------------------------------
+// ControlServer:
+// --------------------------------------------------------------
+// Listens on a Unix-domain stream socket and speaks a line protocol
+// (try `echo help | socat - UNIX-CONNECT:/tmp/gol.sock`):
+//
+//   pause | resume | step N | rule B3/S23
+//   stamp <pattern> <row> <col> | snapshot <path>
+//   stats | help | quit
+//
+// A background thread owns the socket. It parses each line and
+// pushes a ControlCommand onto a lock-free queue that the engine
+// drains between generations with poll(), so neither side ever
+// waits on the other.
+//
+// "stats" is answered directly by the socket thread from the last
+// snapshot handed over with publishStats(); it never touches the
+// grid. The snapshot is copied as a unit under a mutex (held only
+// for the copy), so a reply never mixes two generations.
+// --------------------------------------------------------------
+class ControlServer {
+   public:
+    explicit ControlServer(const std::string& socketPath, size_t queueCapacity = 256);
+    ~ControlServer();
+
+    ControlServer(const ControlServer&)            = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    // Engine side: fetch the next pending command, if any.
+    bool poll(ControlCommand& command) { return queue.tryPop(command); }
+
+    // Engine side: hand over the latest statistics (one short
+    // locked copy, call once per generation).
+    void publishStats(const AutomatonStats& stats, bool paused, const LifeRule& rule);
+
+   private:
+    void serve();
+    std::string handleLine(const std::string& line);
+
+    std::string path;
+    int listenFd = -1;
+    std::atomic<bool> stopping{false};
+    MpscQueue<ControlCommand> queue;
+
+    struct StatsSnapshot {
+        AutomatonStats stats;
+        bool paused = false;
+        LifeRule rule;
+    };
+    std::mutex statsLock;
+    StatsSnapshot latest;  // guarded by statsLock
+
+    std::thread worker;  // started last, after every member above exists
+};
@@ -1,25 +1,48 @@
 #pragma once
 
+#include "BitBoard.hpp"
 #include "CellularAutomaton.hpp"
+#include "LifeRule.hpp"
+#include <chrono>
 #include <iostream>
 #include <vector>
 
 class ConwayLife : public CellularAutomaton {
+   protected:
+    LifeRule rule;  // B3/S23 unless changed with setRule()
+
    public:
-    ConwayLife(int r, int c);
+    ConwayLife(int r, int c, double density = 0.25);
     void step() override;           // Conway's rules
     void display() const override;  // ASCII visualization
+
+    // Fast-forward on a bit-packed copy of the board (see below).
+    uint64_t advance(uint64_t n, const std::function<bool(uint64_t)>& progress = nullptr) override;
+
+    int nextState(int state, int neighbors) const override {
+        return rule.next(state, neighbors);
+    }
+
+    // Swap in any Life-like rule (e.g. HighLife "B36/S23"). Any
+    // tile may now evolve differently, so all are marked dirty.
+    void setRule(const LifeRule& r) {
+        rule = r;
+        std::fill(dirty.begin(), dirty.end(), 1);
+    }
+    const LifeRule& getRule() const { return rule; }
 };
 
 // --------------------------------------------------------------
 // Constructor:
 // Calls the base CellularAutomaton(r, c) to set up grid size,
-// then initializes the grid with a random pattern.
+// then initializes the grid with a random pattern of the given
+// density (0 leaves it empty without touching rand()).
 // --------------------------------------------------------------
-ConwayLife::ConwayLife(int r, int c)
+inline ConwayLife::ConwayLife(int r, int c, double density)
     : CellularAutomaton(r, c)  // delegate grid creation to base class
 {
-    randomize(0.25);  // 25% initial density
+    if (density > 0)
+        randomize(density);
 }
 
 // --------------------------------------------------------------
@@ -34,26 +57,40 @@ ConwayLife::ConwayLife(int r, int c)
 // Implementation:
 //   - Create a separate "next" grid so updates do not interfere.
 //   - Use countNeighbors() inherited from CellularAutomaton.
+//   - Keep births/deaths/population in 'counters' as we go, so
+//     nobody has to rescan the grid for statistics.
+//
+// The birth/survival counts come from 'rule' (Conway by default).
+// With the heatmap enabled, each row's age/activity is updated as
+// soon as the row is done.
 // --------------------------------------------------------------
-void ConwayLife::step() {
+inline void ConwayLife::step() {
     // Copy current grid so we can compute next generation safely
     std::vector<std::vector<int>> next = grid;
+    long born = 0, died = 0, alive = 0;
 
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < cols; ++j) {
             int n = countNeighbors(i, j);  // # of live neighbors
 
-            if (grid[i][j]) {
-                // Live cell: survives only with 2 or 3 neighbors
-                next[i][j] = (n == 2 || n == 3);
-            } else {
-                // Dead cell: birth occurs only with exactly 3 neighbors
-                next[i][j] = (n == 3);
-            }
+            // Live cell: survives if n is in the S list
+            // Dead cell: is born if n is in the B list
+            next[i][j] = rule.next(grid[i][j], n);
+
+            born += !grid[i][j] && next[i][j];
+            died += grid[i][j] && !next[i][j];
+            alive += next[i][j];
         }
+        if (heatmapOn)
+            updateHeatmapRow(i, grid[i], next[i]);
     }
 
     grid = next;  // Commit new generation
+
+    counters.generation++;
+    counters.population = alive;
+    counters.births     = born;
+    counters.deaths     = died;
 }
 
 // --------------------------------------------------------------
@@ -61,9 +98,76 @@ void ConwayLife::step() {
 // Prints '#' for live cells and '.' for dead cells.
 // Simple text-based visualization for terminal.
 // --------------------------------------------------------------
-void ConwayLife::display() const {
+inline void ConwayLife::display() const {
     for (const auto& row : grid) {
         for (int cell : row) std::cout << (cell ? "⬜" : "  ");
         std::cout << "\n";
     }
-}
\ No newline at end of file
+}
+
+// --------------------------------------------------------------
+// advance(n, progress)
+// Jumps 'n' generations ahead without touching the nested-vector
+// grid until the end.
+//
+// Two things make this fast:
+//   1. The board is copied into a BitBoard, which updates 64 cells
+//      per machine word instead of one cell per countNeighbors().
+//   2. Cycle detection (Brent's method): we keep an "anchor" copy of
+//      the board and compare against it each generation, moving the
+//      anchor at powers of two. Once the board repeats with period
+//      p, every remaining whole cycle is skipped arithmetically.
+//      Bounded boards almost always settle into still lifes and
+//      oscillators, so large jumps usually finish in milliseconds.
+//
+// births/deaths are reset, since they describe a single step.
+// --------------------------------------------------------------
+inline uint64_t ConwayLife::advance(uint64_t n, const std::function<bool(uint64_t)>& progress) {
+    if (n == 0)
+        return 0;
+
+    BitBoard board(rows, cols);
+    board.load(grid);
+
+    BitBoard anchor     = board;
+    uint64_t anchorGen  = 0;
+    uint64_t power      = 1;
+    uint64_t period     = 0;  // 0 = no cycle found yet
+    uint64_t done       = 0;
+    auto lastReport     = std::chrono::steady_clock::now();
+
+    while (done < n) {
+        board.step(rule);
+        ++done;
+
+        if (period == 0) {
+            if (board == anchor) {
+                period = done - anchorGen;
+                done += (n - done) / period * period;  // skip whole cycles
+            } else if (done - anchorGen == power) {
+                anchor    = board;
+                anchorGen = done;
+                power *= 2;
+            }
+        }
+
+        // Report roughly every 50 ms; the clock is only read every
+        // 256 generations to keep it out of the hot loop.
+        if (progress && done % 256 == 0 && done < n) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastReport > std::chrono::milliseconds(50)) {
+                lastReport = now;
+                if (!progress(done))
+                    break;
+            }
+        }
+    }
+
+    board.store(grid);
+    counters.generation += done;
+    counters.population = board.population();
+    counters.births = counters.deaths = 0;
+    std::fill(dirty.begin(), dirty.end(), 1);
+    resetHeatmap();
+    return done;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "GridView.hpp"
+
+// --------------------------------------------------------------
+// DensityPyramid:
+// --------------------------------------------------------------
+// Live-cell counts of a board snapshot at a series of resolutions:
+// level L holds one count per 2^L x 2^L block of cells (blocks on
+// the right and bottom edges may be partial). Zoomed-out views
+// (minimaps, overviews) read the level whose blocks are about one
+// pixel, so drawing them costs pixels, not cells.
+//
+// build() takes the snapshot and computes level 1 in one pass over
+// the grid; every further level is summed from the one below (a
+// quarter of its size) the first time someone asks for it. All the
+// views rendered from one snapshot share the same levels.
+// --------------------------------------------------------------
+class DensityPyramid {
+   public:
+    static constexpr int MAX_LEVEL = 12;  // 4096 x 4096 blocks
+
+    void build(const GridView& grid);
+
+    int gridRows() const { return rows; }
+    int gridCols() const { return cols; }
+    int levelRows(int level) const { return (rows + (1 << level) - 1) >> level; }
+    int levelCols(int level) const { return (cols + (1 << level) - 1) >> level; }
+
+    // Counts at 'level' (1..MAX_LEVEL), row-major levelRows x levelCols.
+    const std::vector<uint32_t>& level(int level);
+
+    // Smallest level whose blocks span at least 'cellsPerPixel' cells.
+    static int levelFor(double cellsPerPixel);
+
+    // ----------------------------------------------------------
+    // shade(): counts at 'level' as 0-255 densities, for a window
+    // of rows x cols blocks starting at (row0, col0). Any live cell
+    // makes a block at least 'floor', so lone gliders stay visible
+    // on a large board.
+    // ----------------------------------------------------------
+    void shade(int level, int row0, int col0, int rows, int cols, std::vector<uint8_t>& out, int floor = 64);
+
+    uint64_t builds() const { return buildCount; }
+
+   private:
+    int rows = 0, cols = 0;
+    std::vector<std::vector<uint32_t>> levels;  // [0] unused
+    std::vector<uint8_t> line;                  // one grid row, 0/1
+    int built = 0;                              // highest level computed
+    uint64_t buildCount = 0;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "HaloTransport.hpp"
+
+// --------------------------------------------------------------
+// DistributedLife:
+// --------------------------------------------------------------
+// Conway's Game of Life split across several worker PROCESSES.
+//
+// The board is cut into a grid of rectangular subdomains, one per
+// worker. Each worker keeps its cells plus a one-cell halo and,
+// every generation:
+//
+//   1. sends its 8 edge pieces (4 sides + 4 corners) to neighbors
+//   2. updates its interior cells (they never read the halo)
+//   3. receives the neighbors' edges into its halo
+//   4. updates its border cells
+//
+// so halo traffic overlaps with interior computation. Cells outside
+// the board are always dead, exactly like ConwayLife, so results
+// are identical to a single-process run.
+//
+// run(n) forks the workers once for n generations; step() is just
+// run(1) and is mainly there to satisfy the CellularAutomaton API.
+// --------------------------------------------------------------
+class DistributedLife : public ConwayLife {
+   public:
+    DistributedLife(int r, int c, int workers);
+
+    void step() override;
+
+    // Advance 'generations' generations using all workers.
+    void run(int generations);
+
+    // Fast-forward in chunks of run() so progress can be reported
+    // (and the jump cancelled) between chunks.
+    uint64_t advance(uint64_t n, const std::function<bool(uint64_t)>& progress = nullptr) override;
+
+    int workerCount() const { return workers; }
+
+    // Process-grid shape chosen for the current worker count.
+    int workerRows() const { return procRows; }
+    int workerCols() const { return procCols; }
+
+   protected:
+    // Extension point for other transports (e.g. sockets). Called
+    // once per run() in the parent, before any worker is forked.
+    virtual std::unique_ptr<HaloTransport> makeTransport(int channels, size_t slotBytes);
+
+   private:
+    struct Subdomain {
+        int row0, col0;  // top-left cell in global coordinates
+        int rows, cols;
+    };
+
+    Subdomain subdomain(int worker) const;
+    int neighbor(int worker, int dir) const;  // -1 if off the board
+
+    void runWorker(int worker, HaloTransport& transport, uint8_t* shared, int generations) const;
+
+    int workers;
+    int procRows, procCols;
+};
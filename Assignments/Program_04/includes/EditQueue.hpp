@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "CellularAutomaton.hpp"
+#include "MpscQueue.hpp"
+
+// --------------------------------------------------------------
+// CellEdit: one requested change to one cell.
+// --------------------------------------------------------------
+struct CellEdit {
+    enum Op : uint8_t { Set, Clear, Toggle };
+
+    int row = 0;
+    int col = 0;
+    Op op   = Set;
+};
+
+// --------------------------------------------------------------
+// EditQueue:
+// --------------------------------------------------------------
+// Batched cell edits from the UI (or any other thread) to the
+// engine. Producers never touch the grid: they push CellEdits onto
+// a lock-free MPSC queue, and the engine applies everything that is
+// queued in one go between generations with applyTo(). A step()
+// therefore always sees either none or all of a frame's edits, and
+// the edited tiles are marked dirty by setCell().
+//
+// Producers should go through an EditWriter (below), which keeps
+// edits that did not fit and retries them on the next flush, so a
+// burst of painting is delayed rather than dropped.
+// --------------------------------------------------------------
+class EditQueue {
+   public:
+    explicit EditQueue(size_t capacity = 1 << 14) : queue(capacity) {}
+
+    bool tryPush(const CellEdit& edit) { return queue.tryPush(edit); }
+
+    // ----------------------------------------------------------
+    // applyTo(): engine side. Drains the queue into 'automaton'
+    // and returns how many edits were applied.
+    // ----------------------------------------------------------
+    size_t applyTo(CellularAutomaton& automaton) {
+        size_t applied = 0;
+        CellEdit edit;
+        while (queue.tryPop(edit)) {
+            switch (edit.op) {
+                case CellEdit::Set:
+                    automaton.setCell(edit.row, edit.col, 1);
+                    break;
+                case CellEdit::Clear:
+                    automaton.setCell(edit.row, edit.col, 0);
+                    break;
+                case CellEdit::Toggle:
+                    automaton.toggleCell(edit.row, edit.col);
+                    break;
+            }
+            ++applied;
+        }
+        return applied;
+    }
+
+   private:
+    MpscQueue<CellEdit> queue;
+};
+
+// --------------------------------------------------------------
+// EditWriter:
+// Per-producer front end for an EditQueue. add() never blocks:
+// whatever the queue cannot take right now waits in a local
+// backlog (in order) until the next add() or flush().
+// --------------------------------------------------------------
+class EditWriter {
+   public:
+    explicit EditWriter(EditQueue& queue) : queue(queue) {}
+
+    void add(const CellEdit& edit) {
+        if (!backlog.empty() || !queue.tryPush(edit)) {
+            backlog.push_back(edit);
+            flush();
+        }
+    }
+
+    // Retry backlogged edits; call once per frame.
+    void flush() {
+        size_t sent = 0;
+        while (sent < backlog.size() && queue.tryPush(backlog[sent])) ++sent;
+        backlog.erase(backlog.begin(), backlog.begin() + sent);
+    }
+
+    size_t pending() const { return backlog.size(); }
+
+   private:
+    EditQueue& queue;
+    std::vector<CellEdit> backlog;
+};
@@ -0,0 +1,226 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BitBoard.hpp"
+#include "ConwayLife.hpp"
+#include "GridView.hpp"
+#include "LifeRule.hpp"
+#include "SymmetricLife.hpp"
+
+// --------------------------------------------------------------
+// RunObserver: what Engine::run() reports back, and how often.
+//   every   call frame() every N generations (by generation
+//           number, like Recorder's 'every') and at the last
+//           generation of the run; 0 = only at the end
+//   frame   gets the generation and a view of the board; returning
+//           false stops the run there
+// --------------------------------------------------------------
+struct RunObserver {
+    uint64_t every = 0;
+    std::function<bool(uint64_t generation, const GridView& board)> frame;
+};
+
+// --------------------------------------------------------------
+// Engine:
+// --------------------------------------------------------------
+// A Life engine picked by name at run time (EngineRegistry) for
+// batch work: load a board, run() many generations, read it back
+// through view().
+//
+// The only virtual call is run() itself. Inside, KernelEngine loops
+// over its kernel's step() with static dispatch, so the compiler
+// can inline it, and only leaves the loop to call the observer. For
+// a million tiny boards that is one indirect call per board and
+// observation instead of one per generation.
+// --------------------------------------------------------------
+class Engine {
+   public:
+    virtual ~Engine() = default;
+
+    virtual const std::string& name() const = 0;
+
+    // Replace the board (same size) and set the generation counter.
+    virtual void load(const GridView& board, uint64_t generation = 0) = 0;
+
+    // Step n generations. Returns how many were run (fewer if the
+    // observer stopped it).
+    virtual uint64_t run(uint64_t n, const RunObserver& observer = RunObserver()) = 0;
+
+    virtual GridView view() const = 0;
+    virtual uint64_t generation() const = 0;
+    virtual long population() const = 0;
+};
+
+// --------------------------------------------------------------
+// KernelEngine<Kernel>: an Engine around any class with
+//   void step();  GridView view() const;  long population() const;
+//   void load(const GridView&);
+// Kernels are plain classes with no virtual functions; 'final' lets
+// the compiler devirtualize calls made through a KernelEngine.
+// --------------------------------------------------------------
+template <typename Kernel>
+class KernelEngine final : public Engine {
+   public:
+    template <typename... Args>
+    KernelEngine(std::string name, Args&&... args) : id(std::move(name)), kernel(std::forward<Args>(args)...) {}
+
+    const std::string& name() const override { return id; }
+
+    void load(const GridView& board, uint64_t generation) override {
+        kernel.load(board);
+        gen = generation;
+    }
+
+    uint64_t run(uint64_t n, const RunObserver& observer) override {
+        uint64_t done = 0;
+        while (done < n) {
+            // Up to the next generation the observer wants to see.
+            uint64_t chunk = n - done;
+            if (observer.every)
+                chunk = std::min(chunk, observer.every - gen % observer.every);
+            for (uint64_t i = 0; i < chunk; ++i) kernel.step();
+            done += chunk;
+            gen += chunk;
+
+            bool due = done == n || (observer.every && gen % observer.every == 0);
+            if (observer.frame && due && !observer.frame(gen, kernel.view()))
+                break;
+        }
+        return done;
+    }
+
+    GridView view() const override { return kernel.view(); }
+    uint64_t generation() const override { return gen; }
+    long population() const override { return kernel.population(); }
+
+    Kernel& get() { return kernel; }
+
+   private:
+    std::string id;
+    Kernel kernel;
+    uint64_t gen = 0;
+};
+
+// --------------------------------------------------------------
+// Built-in kernels
+//   nested     ConwayLife's own step() on the nested-vector grid
+//              (the reference the others must match)
+//   bitpacked  BitBoard: 64 cells per word, bit-sliced adders
+// --------------------------------------------------------------
+struct NestedKernel {
+    ConwayLife life;
+
+    NestedKernel(int rows, int cols, const LifeRule& rule) : life(rows, cols, 0.0) {
+        life.setRule(rule);
+    }
+
+    void step() { life.ConwayLife::step(); }  // qualified: no virtual dispatch
+    GridView view() const { return life.view(); }
+    long population() const { return life.getStats().population; }
+    void load(const GridView& board) {
+        std::vector<std::vector<int>> grid;
+        board.copyTo(grid);
+        life.restore(grid, 0);
+    }
+};
+
+struct BitPackedKernel {
+    BitBoard board;
+    LifeRule rule;
+
+    BitPackedKernel(int rows, int cols, const LifeRule& rule) : board(rows, cols), rule(rule) {}
+
+    void step() { board.step(rule); }
+    GridView view() const { return board.view(); }
+    long population() const { return board.population(); }
+    void load(const GridView& grid) { board.load(grid); }
+};
+
+// --------------------------------------------------------------
+// SymmetricKernel: SymmetricLife, which steps only the fundamental
+// domain of a symmetric board. load() expects a board with that
+// symmetry; view() expands the domain into a full board, so it
+// costs a copy per observation rather than per generation.
+// --------------------------------------------------------------
+struct SymmetricKernel {
+    SymmetricLife life;
+    mutable std::vector<std::vector<int>> full;
+
+    SymmetricKernel(int rows, int cols, const LifeRule& rule, Symmetry symmetry)
+        : life(rows, cols, symmetry, rule) {}
+
+    void step() { life.step(); }
+    GridView view() const {
+        life.expand(full);
+        return full;
+    }
+    long population() const { return life.population(); }
+    void load(const GridView& board) {
+        board.copyTo(full);
+        life.load(full);
+    }
+};
+
+// --------------------------------------------------------------
+// EngineRegistry:
+// --------------------------------------------------------------
+// Name → factory. create("bitpacked", rows, cols, rule) builds an
+// engine with an empty board; unknown names throw with the list of
+// known ones. add() registers more engines (before they are asked
+// for; the table is not locked).
+// --------------------------------------------------------------
+class EngineRegistry {
+   public:
+    using Factory = std::function<std::unique_ptr<Engine>(int rows, int cols, const LifeRule& rule)>;
+
+    static void add(const std::string& name, Factory factory) { table()[name] = std::move(factory); }
+
+    static std::unique_ptr<Engine> create(const std::string& name, int rows, int cols,
+                                          const LifeRule& rule = LifeRule()) {
+        auto it = table().find(name);
+        if (it == table().end()) {
+            std::string known;
+            for (const auto& n : names()) known += (known.empty() ? "" : ", ") + n;
+            throw std::invalid_argument("unknown engine '" + name + "' (" + known + ")");
+        }
+        return it->second(rows, cols, rule);
+    }
+
+    // Factory for a SymmetricKernel engine. The symmetry is not part
+    // of create()'s arguments, so callers register one, e.g.
+    //   EngineRegistry::add("symmetric", EngineRegistry::symmetric(Symmetry::D4));
+    static Factory symmetric(Symmetry symmetry) {
+        return [symmetry](int rows, int cols, const LifeRule& rule) {
+            return std::make_unique<KernelEngine<SymmetricKernel>>("symmetric", rows, cols, rule, symmetry);
+        };
+    }
+
+    static std::vector<std::string> names() {
+        std::vector<std::string> out;
+        for (const auto& entry : table()) out.push_back(entry.first);
+        return out;
+    }
+
+   private:
+    template <typename Kernel>
+    static Factory kernel(const std::string& name) {
+        return [name](int rows, int cols, const LifeRule& rule) {
+            return std::make_unique<KernelEngine<Kernel>>(name, rows, cols, rule);
+        };
+    }
+
+    static std::map<std::string, Factory>& table() {
+        static std::map<std::string, Factory> engines = {
+            {"nested", kernel<NestedKernel>("nested")},
+            {"bitpacked", kernel<BitPackedKernel>("bitpacked")},
+        };
+        return engines;
+    }
+};
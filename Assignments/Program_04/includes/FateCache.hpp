@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// --------------------------------------------------------------
+// ClusterFate:
+// --------------------------------------------------------------
+// What an isolated cluster of cells eventually turns into, found by
+// evolving it on its own (see Census.hpp).
+// --------------------------------------------------------------
+struct ClusterFate {
+    bool settled   = false;  // reached a periodic state within the limits
+    int period     = 0;      // 1 = still life
+    int settleGen  = 0;      // first generation of the cycle
+    long population = 0;     // population at settleGen
+    std::vector<std::string> objects;  // names of the settled objects
+};
+
+struct FateCacheStats {
+    uint64_t hits      = 0;
+    uint64_t misses    = 0;
+    uint64_t evictions = 0;
+    size_t entries     = 0;
+    size_t bytes       = 0;  // estimated, keys + fates + bookkeeping
+
+    double hitRate() const { return hits + misses ? (double)hits / (hits + misses) : 0.0; }
+};
+
+// --------------------------------------------------------------
+// FateCache:
+// --------------------------------------------------------------
+// A bounded, thread-safe map from a cluster's CANONICAL key (its
+// bitmap in the orientation that sorts first, plus the rule) to its
+// fate, so a census never evolves the same debris twice.
+//
+// The table is split into shards by the key's hash; each shard has
+// its own mutex and its own least-recently-used list, so worker
+// threads mostly take different locks. A shard evicts its oldest
+// entries once it holds more than maxBytes / shards.
+//
+// Fates are deterministic, so two threads that miss on the same key
+// compute the same value; insert() keeps whichever arrived first.
+// --------------------------------------------------------------
+class FateCache {
+   public:
+    explicit FateCache(size_t maxBytes = 64u << 20, int shards = 16);
+
+    // Copy the fate for 'key' into 'out' if it is cached.
+    bool lookup(const std::string& key, ClusterFate& out);
+
+    void insert(const std::string& key, const ClusterFate& fate);
+
+    FateCacheStats stats() const;
+    void clear();
+
+   private:
+    struct Shard {
+        std::mutex lock;
+        std::list<std::pair<std::string, ClusterFate>> lru;  // most recent first
+        std::unordered_map<std::string, std::list<std::pair<std::string, ClusterFate>>::iterator> index;
+        size_t bytes = 0;
+    };
+
+    Shard& shardFor(const std::string& key);
+    static size_t entryBytes(const std::string& key, const ClusterFate& fate);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t shardBudget;
+
+    std::atomic<uint64_t> hits{0}, misses{0}, evictions{0};
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// --------------------------------------------------------------
+// Frame: one captured board, one byte per cell (a palette index:
+// 0/1 for dead/alive, or an age/activity value).
+// --------------------------------------------------------------
+struct Frame {
+    uint64_t generation = 0;
+    int rows = 0, cols = 0;
+    std::vector<uint8_t> cells;  // rows * cols, row-major
+};
+
+// --------------------------------------------------------------
+// FrameQueue:
+// --------------------------------------------------------------
+// A fixed pool of Frames cycling between the engine (producer) and
+// one encoder thread (consumer):
+//
+//   engine:  acquire() a free frame → fill it → submit()
+//   encoder: next() a ready frame   → encode it → release()
+//
+// All frames are allocated up front, so memory does not grow with
+// the length of the run. The lock is held only to move a pointer
+// between lists, never while a frame is filled or encoded, so the
+// engine's cost per frame is the copy into the buffer.
+//
+// When every frame is busy, acquire(false) returns nullptr at once
+// (the caller drops the frame); acquire(true) waits for the encoder.
+// --------------------------------------------------------------
+class FrameQueue {
+   public:
+    explicit FrameQueue(size_t depth = 8) {
+        for (size_t i = 0; i < depth; ++i) {
+            pool.push_back(std::make_unique<Frame>());
+            freeList.push_back(pool.back().get());
+        }
+    }
+
+    FrameQueue(const FrameQueue&)            = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+
+    Frame* acquire(bool wait) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (wait)
+            freed.wait(guard, [&] { return !freeList.empty(); });
+        if (freeList.empty())
+            return nullptr;
+        Frame* f = freeList.front();
+        freeList.pop_front();
+        return f;
+    }
+
+    void submit(Frame* frame) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            readyList.push_back(frame);
+        }
+        ready.notify_one();
+    }
+
+    // Consumer: blocks until a frame is ready. Returns nullptr once
+    // close() has been called and every submitted frame was taken.
+    Frame* next() {
+        std::unique_lock<std::mutex> guard(lock);
+        ready.wait(guard, [&] { return !readyList.empty() || closed; });
+        if (readyList.empty())
+            return nullptr;
+        Frame* f = readyList.front();
+        readyList.pop_front();
+        return f;
+    }
+
+    void release(Frame* frame) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            freeList.push_back(frame);
+        }
+        freed.notify_one();
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closed = true;
+        }
+        ready.notify_all();
+    }
+
+   private:
+    std::vector<std::unique_ptr<Frame>> pool;
+    std::deque<Frame*> freeList, readyList;
+    std::mutex lock;
+    std::condition_variable ready, freed;
+    bool closed = false;
+};
@@ -0,0 +1,179 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+// --------------------------------------------------------------
+// FrameScheduler:
+// --------------------------------------------------------------
+// Paces the main loop at a target frame rate. Instead of sleeping
+// a fixed time after each frame (which stretches every frame by
+// however long the work took), each frame gets a deadline one
+// period after the previous one and wait() sleeps only for what is
+// left of it:
+//
+//   scheduler.wait()              → sleep until the deadline
+//   poll input                    → mark(Input)
+//   apply edits, step             → mark(Update)
+//   render + present              → mark(Render)
+//
+// so input is read right at the deadline, just before the frame it
+// affects. The sleep is a steady_clock sleep_until() that wakes a
+// little early (by the oversleep observed so far) and spins the
+// rest of the way, so frames land within tens of microseconds of
+// their deadline instead of the scheduler's 1-10 ms granularity.
+//
+// A frame that overruns its deadline counts as missed. An overrun
+// shorter than a period is made up by the next frame (its deadline
+// stays on the schedule), so occasional slow frames cost no rate;
+// after a longer stall the schedule restarts from now instead of
+// bursting through the backlog.
+//
+// With a vsync'd renderer at the display's refresh rate, present()
+// already blocks until the next refresh; setVsyncPaced(true) turns
+// the sleep off and lets the display pace the loop (missed frames
+// are still counted against the period). fps <= 0 runs unpaced.
+// --------------------------------------------------------------
+class FrameScheduler {
+   public:
+    enum Phase { Input, Update, Render, Idle, PHASES };
+
+    using Clock = std::chrono::steady_clock;
+
+    // Phase times are per-frame averages over the whole run;
+    // 'recentMs' weights roughly the last 16 frames. Idle is
+    // everything not charged to another phase, mostly the sleep.
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t missed = 0;   // frames whose work overran the deadline
+        double fps       = 0;  // achieved, over the run
+        double maxLateMs = 0;  // worst overrun
+        double avgMs[PHASES]    = {};
+        double recentMs[PHASES] = {};
+    };
+
+    explicit FrameScheduler(double fps) {
+        setFps(fps);
+        start = last = Clock::now();
+        deadline     = start + period;
+    }
+
+    void setFps(double fps) {
+        target = fps;
+        period = fps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps))
+                         : Clock::duration::zero();
+    }
+    double fps() const { return target; }
+    double periodMs() const { return std::chrono::duration<double, std::milli>(period).count(); }
+
+    void setVsyncPaced(bool on) { vsyncPaced = on; }
+    bool isVsyncPaced() const { return vsyncPaced; }
+
+    // Charge the time since the previous mark to 'phase'; returns
+    // that time in ms.
+    double mark(Phase phase) {
+        Clock::time_point now = Clock::now();
+        double ms             = std::chrono::duration<double, std::milli>(now - last).count();
+        phaseMs[phase] += ms;
+        last = now;
+        return ms;
+    }
+
+    // ----------------------------------------------------------
+    // wait(): end the current frame and sleep until the next
+    // deadline. Returns false if the frame missed its deadline.
+    // ----------------------------------------------------------
+    bool wait() {
+        Clock::time_point now = Clock::now();
+        bool onTime           = now <= deadline || period == Clock::duration::zero();
+        if (!onTime) {
+            ++missed;
+            maxLateMs = std::max(maxLateMs, std::chrono::duration<double, std::milli>(now - deadline).count());
+            if (now - deadline >= period)
+                deadline = now;
+        }
+        if (!vsyncPaced)
+            sleepUntil(deadline);
+        deadline += period;  // the next frame's
+        endFrame();
+        return onTime;
+    }
+
+    // ----------------------------------------------------------
+    // resync(): end the current frame without waiting and restart
+    // the schedule from now, e.g. after a fast-forward or while
+    // running "step N" flat out. Not counted as a miss.
+    // ----------------------------------------------------------
+    void resync() {
+        deadline = Clock::now() + period;
+        endFrame();
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.frames    = frames;
+        s.missed    = missed;
+        s.maxLateMs = maxLateMs;
+        double secs = std::chrono::duration<double>(last - start).count();
+        s.fps       = secs > 0 ? frames / secs : 0;
+        for (int p = 0; p < PHASES; ++p) {
+            s.avgMs[p]    = frames ? totalMs[p] / frames : 0;
+            s.recentMs[p] = recentMs[p];
+        }
+        return s;
+    }
+
+    // One line for logs: frames, misses, achieved rate and phases.
+    std::string summary() const {
+        Stats s = stats();
+        char line[256];
+        std::snprintf(line, sizeof line,
+                      "%llu frames at %.1f fps (target %.1f), %llu missed (%.1f%%, worst +%.1f ms); "
+                      "input %.2f, update %.2f, render %.2f, idle %.2f ms/frame",
+                      (unsigned long long)s.frames, s.fps, target, (unsigned long long)s.missed,
+                      s.frames ? 100.0 * s.missed / s.frames : 0.0, s.maxLateMs, s.avgMs[Input], s.avgMs[Update],
+                      s.avgMs[Render], s.avgMs[Idle]);
+        return line;
+    }
+
+   private:
+    // Sleep to just short of 'when', then spin. 'slack' follows
+    // twice the recent oversleep of sleep_until(), within bounds.
+    void sleepUntil(Clock::time_point when) {
+        Clock::time_point early = when - slack;
+        if (Clock::now() < early) {
+            std::this_thread::sleep_until(early);
+            Clock::duration over = Clock::now() - early;
+            slack = std::clamp((slack * 7 + over * 2) / 8, minSlack, maxSlack);
+        }
+        while (Clock::now() < when) std::this_thread::yield();
+    }
+
+    void endFrame() {
+        mark(Idle);
+        ++frames;
+        for (int p = 0; p < PHASES; ++p) {
+            totalMs[p] += phaseMs[p];
+            recentMs[p] = frames == 1 ? phaseMs[p] : recentMs[p] + (phaseMs[p] - recentMs[p]) / 16;
+            phaseMs[p]  = 0;
+        }
+    }
+
+    static constexpr Clock::duration minSlack = std::chrono::microseconds(100);
+    static constexpr Clock::duration maxSlack = std::chrono::milliseconds(4);
+
+    double target = 0;
+    Clock::duration period{};
+    bool vsyncPaced = false;
+    Clock::duration slack = std::chrono::milliseconds(1);
+
+    Clock::time_point start, last, deadline;
+    double phaseMs[PHASES]  = {};  // this frame
+    double totalMs[PHASES]  = {};
+    double recentMs[PHASES] = {};
+    uint64_t frames = 0, missed = 0;
+    double maxLateMs = 0;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Palette.hpp"
+#include "Recorder.hpp"
+
+// --------------------------------------------------------------
+// GifRecorder:
+// --------------------------------------------------------------
+// Streams a run into an animated GIF (GIF89a, looping forever).
+//
+// Cell values index a fixed global color table taken from a
+// Palette: 2 colors (dead/alive) for cell recordings, 256 for
+// age/activity maps. Each frame is compared with what a viewer
+// shows at that point and only the bounding rectangle of the
+// changed cells is LZW-encoded; a frame with no change just
+// lengthens the previous frame's delay. Encoding happens on the
+// Recorder's worker thread, and memory is a few board-sized
+// buffers however long the run is.
+//
+// Disposal (what the viewer does with a frame before the next):
+//   Keep        leave it in place (the usual choice, smallest)
+//   Background  clear its rectangle to color 0
+//   Previous    restore what was there before it
+// The encoder tracks the viewer's canvas, so every mode shows the
+// same pictures; only the file size differs.
+// --------------------------------------------------------------
+class GifRecorder : public Recorder {
+   public:
+    enum class Disposal { Keep = 1, Background = 2, Previous = 3 };
+
+    static Disposal parseDisposal(const std::string& name);
+
+    GifRecorder(const std::string& target, int rows, int cols, int scale = 1, const Palette& palette = Palette::mono(),
+                int colors = 2, int delayCs = 4, Disposal disposal = Disposal::Keep, int every = 1,
+                bool lossless = false);
+    ~GifRecorder() override;
+
+   protected:
+    void encode(const Frame& frame) override;
+    void close() override;
+
+   private:
+    struct Rect {
+        int row0 = 0, col0 = 0, rows = 0, cols = 0;
+    };
+
+    Rect changedRect(const Frame& frame) const;
+    void encodeImage(const Frame& frame, const Rect& rect);
+    void flushPending();
+
+    std::string target;
+    int scale;
+    int colorBits;  // global color table has 1 << colorBits entries
+    int delayCs;
+    Disposal disposal;
+    FILE* out = nullptr;
+
+    std::vector<uint8_t> canvas;   // what a viewer shows after disposal, in cells
+    std::vector<uint8_t> last;     // the last frame encoded
+    bool first = true;
+    std::vector<uint8_t> pending;  // encoded image of the last frame ...
+    int pendingDelay = 0;          // ... waiting for its final delay
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+#include "Palette.hpp"
+
+// --------------------------------------------------------------
+// GridLayer:
+// --------------------------------------------------------------
+// The static bottom layer of a frame: background color plus one
+// grid line every cellSize pixels. Drawing it line by line costs
+// (width + height) / cellSize draw calls every frame, which adds up
+// on a 4K window with small cells, and none of it ever changes.
+//
+// So the layer is rendered once into a target texture and each
+// frame just copies that texture; cells and overlays are drawn on
+// top. The texture is rebuilt only when the output size or the cell
+// size (zoom) changes, or after invalidate() (the driver dropped
+// target contents: SDL_RENDER_TARGETS_RESET). Renderers without
+// target-texture support fall back to drawing the lines directly,
+// still batched into a single SDL_RenderFillRects call.
+// --------------------------------------------------------------
+class GridLayer {
+   public:
+    GridLayer(Rgb background, Rgb lines) : background(background), lines(lines) {}
+    GridLayer(const GridLayer&)            = delete;
+    GridLayer& operator=(const GridLayer&) = delete;
+    ~GridLayer() { invalidate(); }
+
+    // Draw the layer over the whole output.
+    void draw(SDL_Renderer* renderer, int cellSize) {
+        int w = 0, h = 0;
+        SDL_GetRendererOutputSize(renderer, &w, &h);
+        if (w != width || h != height || cellSize != cellPx || (!texture && !direct)) {
+            invalidate();
+            width   = w;
+            height  = h;
+            cellPx  = cellSize;
+            texture = build(renderer);
+            direct  = !texture;
+        }
+        if (texture)
+            SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+        else
+            paint(renderer);
+    }
+
+    // Forget the cached texture; the next draw() rebuilds it.
+    void invalidate() {
+        if (texture)
+            SDL_DestroyTexture(texture);
+        texture = nullptr;
+        direct  = false;
+    }
+
+   private:
+    // Render the layer into a new target texture (nullptr if the
+    // renderer cannot render to textures).
+    SDL_Texture* build(SDL_Renderer* renderer) {
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(renderer, &info) != 0 || !(info.flags & SDL_RENDERER_TARGETTEXTURE))
+            return nullptr;
+        SDL_Texture* t = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!t)
+            return nullptr;
+        if (SDL_SetRenderTarget(renderer, t) != 0) {
+            SDL_DestroyTexture(t);
+            return nullptr;
+        }
+        paint(renderer);
+        SDL_SetRenderTarget(renderer, nullptr);
+        return t;
+    }
+
+    // Background, then every line as a 1-pixel rectangle.
+    void paint(SDL_Renderer* renderer) {
+        SDL_SetRenderDrawColor(renderer, background.r, background.g, background.b, 255);
+        SDL_RenderClear(renderer);
+        if (cellPx < 2)
+            return;  // lines would cover every pixel
+
+        std::vector<SDL_Rect> rects;
+        for (int x = 0; x <= width; x += cellPx) rects.push_back({x, 0, 1, height});
+        for (int y = 0; y <= height; y += cellPx) rects.push_back({0, y, width, 1});
+        SDL_SetRenderDrawColor(renderer, lines.r, lines.g, lines.b, 255);
+        SDL_RenderFillRects(renderer, rects.data(), (int)rects.size());
+    }
+
+    Rgb background, lines;
+    SDL_Texture* texture = nullptr;
+    bool direct          = false;  // no target textures: paint every frame
+    int width = 0, height = 0, cellPx = 0;
+};
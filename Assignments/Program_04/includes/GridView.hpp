@@ -0,0 +1,210 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// --------------------------------------------------------------
+// GridView:
+// --------------------------------------------------------------
+// A non-owning, read-only look at a board in whatever layout its
+// engine keeps it, so a frame goes from engine to renderer,
+// recorder or analyzer without being converted or copied:
+//
+//   Format   storage                         from
+//   Rows     vector<vector<int>>, any states CellularAutomaton::view()
+//   Ints     int rows, 'stride' ints apart   flat int buffers
+//   Bytes    uint8_t rows, 'stride' apart    heatmaps, byte engines
+//   Bits     1 bit per cell, bit c & 63 of   BitBoard::view()
+//            word c / 64, 'stride' words
+//
+// Consumers read it a row segment at a time through rowStates()
+// (palette indices), rowAlive() (0/1) or rowBits() (packed words,
+// the layout BitBoard, History and LiveView share), each with a
+// fast path per format, or test whole blocks with anyAlive(). at()
+// is there for random access but costs a switch per cell.
+//
+// A view is only valid while the board it looks at is neither
+// stepped nor resized; take a new one each frame.
+// --------------------------------------------------------------
+class GridView {
+   public:
+    enum class Format { Rows, Ints, Bytes, Bits };
+
+    GridView() = default;
+
+    // Implicit, so code holding a nested-vector grid passes it as is.
+    GridView(const std::vector<std::vector<int>>& grid)
+        : fmt(Format::Rows), nrows((int)grid.size()), ncols(grid.empty() ? 0 : (int)grid[0].size()), nested(&grid) {}
+
+    static GridView ints(const int* cells, int rows, int cols, size_t stride = 0) {
+        return GridView(Format::Ints, cells, rows, cols, stride ? stride : cols);
+    }
+    static GridView bytes(const uint8_t* cells, int rows, int cols, size_t stride = 0) {
+        return GridView(Format::Bytes, cells, rows, cols, stride ? stride : cols);
+    }
+    static GridView bits(const uint64_t* words, int rows, int cols, size_t wordsPerRow = 0) {
+        return GridView(Format::Bits, words, rows, cols, wordsPerRow ? wordsPerRow : (cols + 63) / 64);
+    }
+
+    Format format() const { return fmt; }
+    int rows() const { return nrows; }
+    int cols() const { return ncols; }
+    size_t stride() const { return step; }  // in elements; 0 for Rows
+    bool empty() const { return nrows == 0 || ncols == 0; }
+
+    // Largest state the format can hold (1 for Bits, 255 for Bytes)
+    int maxState() const { return fmt == Format::Bits ? 1 : fmt == Format::Bytes ? 255 : 0x7fffffff; }
+
+    // Direct row access for code with its own per-format loops.
+    const int* intRow(int r) const {
+        return fmt == Format::Rows ? (*nested)[r].data() : static_cast<const int*>(base) + r * step;
+    }
+    const uint8_t* byteRow(int r) const { return static_cast<const uint8_t*>(base) + r * step; }
+    const uint64_t* bitRow(int r) const { return static_cast<const uint64_t*>(base) + r * step; }
+
+    int at(int r, int c) const {
+        switch (fmt) {
+            case Format::Bytes:
+                return byteRow(r)[c];
+            case Format::Bits:
+                return (bitRow(r)[c >> 6] >> (c & 63)) & 1;
+            default:
+                return intRow(r)[c];
+        }
+    }
+
+    // ----------------------------------------------------------
+    // rowStates(): cells [c0, c0 + n) of row r as palette indices,
+    // states clamped to 0..255.
+    // ----------------------------------------------------------
+    void rowStates(int r, int c0, int n, uint8_t* out) const {
+        switch (fmt) {
+            case Format::Bytes:
+                std::memcpy(out, byteRow(r) + c0, n);
+                break;
+            case Format::Bits:
+                unpackBits(bitRow(r), c0, n, out);
+                break;
+            default: {
+                const int* in = intRow(r) + c0;
+                for (int c = 0; c < n; ++c) out[c] = (uint8_t)std::min(std::max(in[c], 0), 255);
+            }
+        }
+    }
+
+    // Same, but any non-zero state reads as 1.
+    void rowAlive(int r, int c0, int n, uint8_t* out) const {
+        switch (fmt) {
+            case Format::Bytes: {
+                const uint8_t* in = byteRow(r) + c0;
+                for (int c = 0; c < n; ++c) out[c] = in[c] != 0;
+                break;
+            }
+            case Format::Bits:
+                unpackBits(bitRow(r), c0, n, out);
+                break;
+            default: {
+                const int* in = intRow(r) + c0;
+                for (int c = 0; c < n; ++c) out[c] = in[c] != 0;
+            }
+        }
+    }
+
+    // Whole row r packed 64 cells per word ((cols + 63) / 64 words,
+    // unused high bits zero), live = non-zero.
+    void rowBits(int r, uint64_t* out) const {
+        const int words = (ncols + 63) / 64;
+        if (fmt == Format::Bits) {
+            std::memcpy(out, bitRow(r), words * sizeof(uint64_t));
+            return;
+        }
+        std::fill(out, out + words, 0);
+        if (fmt == Format::Bytes) {
+            const uint8_t* in = byteRow(r);
+            for (int c = 0; c < ncols; ++c) out[c >> 6] |= (uint64_t)(in[c] != 0) << (c & 63);
+        } else {
+            const int* in = intRow(r);
+            for (int c = 0; c < ncols; ++c) out[c >> 6] |= (uint64_t)(in[c] != 0) << (c & 63);
+        }
+    }
+
+    // True if any cell of the block [row0, row0+h) x [col0, col0+w)
+    // (clipped to the board) is alive. Bits test 64 cells at a time.
+    bool anyAlive(int row0, int col0, int h, int w) const {
+        int r1 = std::min(nrows, row0 + h), c1 = std::min(ncols, col0 + w);
+        row0 = std::max(0, row0);
+        col0 = std::max(0, col0);
+        for (int r = row0; r < r1; ++r) {
+            if (fmt == Format::Bits) {
+                const uint64_t* in = bitRow(r);
+                for (int c = col0; c < c1;) {
+                    int k         = std::min(64 - (c & 63), c1 - c);
+                    uint64_t mask = (k == 64 ? ~0ull : (1ull << k) - 1) << (c & 63);
+                    if (in[c >> 6] & mask)
+                        return true;
+                    c += k;
+                }
+            } else if (fmt == Format::Bytes) {
+                const uint8_t* in = byteRow(r);
+                for (int c = col0; c < c1; ++c)
+                    if (in[c])
+                        return true;
+            } else {
+                const int* in = intRow(r);
+                for (int c = col0; c < c1; ++c)
+                    if (in[c])
+                        return true;
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    // forEachTile(): fn(row0, col0, rows, cols) for every tileRows
+    // x tileCols block in row-major order; edge tiles are partial.
+    // ----------------------------------------------------------
+    template <typename Fn>
+    void forEachTile(int tileRows, int tileCols, Fn fn) const {
+        for (int r = 0; r < nrows; r += tileRows)
+            for (int c = 0; c < ncols; c += tileCols)
+                fn(r, c, std::min(tileRows, nrows - r), std::min(tileCols, ncols - c));
+    }
+
+    // A copy in the nested-vector layout, for the few consumers that
+    // must keep a board around (IdleDetector's replay cycle).
+    void copyTo(std::vector<std::vector<int>>& out) const {
+        out.resize(nrows);
+        std::vector<uint8_t> line(ncols);
+        for (int r = 0; r < nrows; ++r) {
+            out[r].resize(ncols);
+            if (fmt == Format::Rows || fmt == Format::Ints) {
+                std::copy_n(intRow(r), ncols, out[r].begin());
+            } else {
+                rowStates(r, 0, ncols, line.data());
+                std::copy(line.begin(), line.end(), out[r].begin());
+            }
+        }
+    }
+
+   private:
+    GridView(Format fmt, const void* base, int rows, int cols, size_t stride)
+        : fmt(fmt), nrows(rows), ncols(cols), step(stride), base(base) {}
+
+    // One word load per 64 cells.
+    static void unpackBits(const uint64_t* words, int c0, int n, uint8_t* out) {
+        for (int c = 0; c < n;) {
+            int bit    = (c0 + c) & 63, k = std::min(64 - bit, n - c);
+            uint64_t w = words[(c0 + c) >> 6] >> bit;
+            for (int i = 0; i < k; ++i) out[c + i] = (w >> i) & 1;
+            c += k;
+        }
+    }
+
+    Format fmt = Format::Rows;
+    int nrows = 0, ncols = 0;
+    size_t step = 0;
+    const void* base                           = nullptr;
+    const std::vector<std::vector<int>>* nested = nullptr;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// --------------------------------------------------------------
+// HaloTransport:
+// --------------------------------------------------------------
+// Moves fixed-size halo messages between worker processes.
+//
+// A "channel" is one directed link (worker i → one of its 8
+// neighbors). Messages on a channel arrive in order. Workers only
+// see this interface, so the shared-memory rings below can later be
+// swapped for a socket transport without touching DistributedLife.
+// --------------------------------------------------------------
+class HaloTransport {
+   public:
+    // Send 'bytes' bytes on 'channel'. May block if the receiver
+    // has fallen more than the ring depth behind.
+    virtual void send(int channel, const uint8_t* data, size_t bytes) = 0;
+
+    // Receive the next message on 'channel' into 'data'. Blocks
+    // until the message is available.
+    virtual void recv(int channel, uint8_t* data, size_t bytes) = 0;
+
+    // Give up on the run: every worker blocked in (or later calling)
+    // send()/recv() throws instead of waiting for a halo that a
+    // failed worker will never produce. Callable from any process.
+    virtual void abort() = 0;
+
+    virtual ~HaloTransport() = default;
+};
+
+// --------------------------------------------------------------
+// ShmRingTransport:
+// --------------------------------------------------------------
+// One single-producer / single-consumer ring per channel, living in
+// an anonymous MAP_SHARED mapping. Create it BEFORE fork() so that
+// every worker process inherits the same mapping.
+//
+// Synchronisation is just two counters per ring (head written by
+// the producer, tail written by the consumer), so a halo exchange
+// never enters the kernel unless a worker has to wait. A shared
+// abort flag ahead of the rings is checked while waiting.
+// --------------------------------------------------------------
+class ShmRingTransport : public HaloTransport {
+   public:
+    ShmRingTransport(int channels, size_t slotBytes, int depth = 4);
+    ~ShmRingTransport() override;
+
+    ShmRingTransport(const ShmRingTransport&)            = delete;
+    ShmRingTransport& operator=(const ShmRingTransport&) = delete;
+
+    void send(int channel, const uint8_t* data, size_t bytes) override;
+    void recv(int channel, uint8_t* data, size_t bytes) override;
+    void abort() override;
+
+   private:
+    // Producer and consumer counters sit on separate cache lines so
+    // the two processes do not false-share.
+    struct alignas(64) Counter {
+        std::atomic<uint64_t> value;
+    };
+    struct Ring {
+        Counter head;  // next sequence number to write
+        Counter tail;  // next sequence number to read
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "shared-memory rings need lock-free 64-bit atomics");
+
+    Counter* aborted() const;  // nonzero once abort() was called
+    void checkAborted() const;
+    Ring* ring(int channel) const;
+    uint8_t* slot(int channel, uint64_t seq) const;
+
+    int channels;
+    size_t slotBytes;
+    int depth;
+    size_t ringBytes;  // header + slots, rounded to a cache line
+    size_t mappedBytes;  // abort flag + rings
+    uint8_t* base;
+};
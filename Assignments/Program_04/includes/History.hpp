@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "GridView.hpp"
+#include "HugePages.hpp"
+
+// --------------------------------------------------------------
+// History:
+// --------------------------------------------------------------
+// A bounded timeline of board states for rewind and undo.
+//
+// Storing getGrid() for every generation would cost rows*cols ints
+// each time, so instead the board is bit-packed and stored as:
+//
+//   - a KEYFRAME (the whole packed board) every 'keyframeInterval'
+//     entries, and
+//   - a DELTA for every other entry: the XOR against the previous
+//     entry, kept only for the tiles that changed.
+//
+// Both are run-length encoded (runs of zero bytes + literals), which
+// is what makes XOR deltas tiny: unchanged areas are all zeros.
+//
+// Reconstructing any retained entry costs one keyframe decode plus
+// at most keyframeInterval-1 delta applications. When the store
+// exceeds 'maxBytes', the oldest keyframe and its deltas are evicted
+// together, so what remains always starts with a keyframe.
+//
+// Generations and user edits share one timeline: record() after a
+// step and record(..., true) after a batch of edits, and undo()
+// walks back one entry at a time regardless of which kind it was.
+// Recording after a seek()/undo() discards the abandoned future.
+// --------------------------------------------------------------
+class History {
+   public:
+    using Grid = std::vector<std::vector<int>>;
+
+    History(int rows, int cols, size_t maxBytes = 64u << 20, int keyframeInterval = 64);
+
+    // Append the current state. 'isEdit' marks user edits (several
+    // entries may share one generation).
+    void record(const GridView& grid, uint64_t generation, bool isEdit = false);
+
+    // Move to the newest retained entry for 'generation' and write its
+    // board into 'out'. Returns false if it was never recorded or has
+    // been evicted.
+    bool seek(uint64_t generation, Grid& out);
+
+    // Step back one entry (the last generation OR the last edit).
+    // Returns false when there is nothing older to go back to.
+    bool undo(Grid& out, uint64_t& generation);
+
+    bool empty() const { return entries.empty(); }
+    uint64_t oldestGeneration() const { return entries.empty() ? 0 : entries.front().generation; }
+    uint64_t currentGeneration() const { return entries.empty() ? 0 : entries[cursor].generation; }
+    size_t size() const { return entries.size(); }
+    size_t bytesUsed() const { return bytes; }
+
+   private:
+    struct Entry {
+        uint64_t generation;
+        bool isEdit;
+        bool isKeyframe;
+        std::vector<uint8_t> data;  // RLE keyframe or RLE tile deltas
+    };
+
+    using Packed = HugeVector<uint64_t>;  // rows x wordsPerRow bits
+
+    void pack(const GridView& grid, Packed& out) const;
+    void unpack(const Packed& packed, Grid& out) const;
+    void reconstruct(size_t index, Packed& out) const;
+    void evict();
+
+    int rows, cols;
+    int wordsPerRow;
+    int tileRows;  // tiles are TILE_ROWS rows x one 64-bit word wide
+    size_t maxBytes;
+    int keyframeInterval;
+
+    std::deque<Entry> entries;
+    size_t cursor = 0;        // entry matching the board right now
+    size_t bytes  = 0;        // sum of entry payload sizes
+    int sinceKeyframe = 0;    // deltas recorded since the last keyframe
+    Packed last;  // packed board of entries[cursor]
+    Packed now;   // record()'s scratch, swapped with 'last'
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// --------------------------------------------------------------
+// HugePages:
+// --------------------------------------------------------------
+// Where the big flat buffers (the BitBoard and SymmetricLife double
+// buffers, History's packed frames) get their memory.
+// With 4 KB pages a multi-gigabyte board needs hundreds of
+// thousands of TLB entries, so a step spends a measurable share of
+// its time on page walks; 2 MB or 1 GB pages cut that by 512x or
+// more.
+//
+// The page size is a process-wide request, set once at start-up:
+//   off   ordinary 4 KB pages
+//   thp   transparent huge pages: 2 MB-aligned, madvise(HUGEPAGE)
+//   2M    explicit 2 MB hugetlb pages (need vm.nr_hugepages)
+//   1G    explicit 1 GB hugetlb pages (need them reserved at boot)
+// A request that cannot be met falls back one step at a time
+// (1G → 2M → thp → off) instead of failing, and every buffer is
+// aligned to the page size it actually got. report() says what was
+// asked for and what was obtained.
+//
+// hugetlb pages are reserved memory and a mapping is rounded up to
+// whole pages, so a 1.5 MB buffer on a 1 GB page would pin 1 GB. A
+// hugetlb size is only tried for a block when rounding wastes at
+// most 1/MAX_WASTE_DIVISOR of it; otherwise the chain starts at the
+// next size down. usage() reports the waste that remains.
+//
+// Only blocks of at least MIN_BYTES are mapped this way; smaller
+// ones go to operator new, where a huge page would be mostly empty.
+// --------------------------------------------------------------
+class HugePages {
+   public:
+    enum class Size { Normal, Transparent, Huge2M, Huge1G };
+
+    static constexpr size_t MIN_BYTES         = 1u << 20;
+    static constexpr size_t MAX_WASTE_DIVISOR = 8;  // waste <= bytes / 8
+
+    static Size parse(const std::string& name);  // off|thp|2M|1G
+    static const char* name(Size size);
+
+    static void request(Size size);
+    static Size requested();
+
+    // Page-aligned memory for 'bytes' bytes, zero-filled when mapped.
+    // Throws std::bad_alloc if even ordinary pages are not available.
+    static void* allocate(size_t bytes);
+    static void release(void* p, size_t bytes);
+
+    // What backs the block at p (Normal for small blocks).
+    static Size backing(const void* p);
+
+    struct Usage {
+        size_t bytes[4]  = {0, 0, 0, 0};  // live mapped bytes, by Size
+        size_t waste     = 0;             // of those, rounding past the requested sizes
+        size_t blocks    = 0;             // live mapped blocks
+        size_t fallbacks = 0;             // blocks that got less than requested
+    };
+    static Usage usage();
+
+    // "requested 2M; mapped 64.0 MB thp, 0.1 MB rounding (2 fallbacks)"
+    static std::string report();
+};
+
+// --------------------------------------------------------------
+// HugePageAllocator<T>: a std allocator over HugePages, e.g.
+// std::vector<uint64_t, HugePageAllocator<uint64_t>>.
+// --------------------------------------------------------------
+template <typename T>
+struct HugePageAllocator {
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(HugePages::allocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) { HugePages::release(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using HugeVector = std::vector<T, HugePageAllocator<T>>;
+
+// --------------------------------------------------------------
+// DoubleBuffer<T>: the current and next generation of a stepped
+// board in one HugePages block, swapped by swapping two offsets.
+//
+// Two separate huge-page blocks both start on a 2 MB boundary, so
+// row i of one and row i of the other map to the same cache sets
+// and keep evicting each other while a step reads one and writes
+// the other (measured: THP ran slower than 4 KB pages). The halves
+// here are kept STAGGER bytes off that alignment instead.
+// --------------------------------------------------------------
+template <typename T>
+class DoubleBuffer {
+   public:
+    static constexpr size_t STAGGER = 4096 + 256;
+
+    explicit DoubleBuffer(size_t n = 0, T fill = T()) { assign(n, fill); }
+
+    // Both halves n elements long, all 'fill'.
+    void assign(size_t n, T fill) {
+        const size_t align = 2u << 20;  // the largest stride that aliases in cache
+        size_t gap         = (STAGGER + align - n * sizeof(T) % align) % align;
+        gap                = (gap + sizeof(T) - 1) / sizeof(T);
+        count              = n;
+        arena.assign(2 * n + gap, fill);
+        a = 0;
+        b = n + gap;
+    }
+
+    T* cur() { return arena.data() + a; }
+    const T* cur() const { return arena.data() + a; }
+    T* next() { return arena.data() + b; }
+
+    void swap() { std::swap(a, b); }
+    size_t size() const { return count; }
+
+    bool operator==(const DoubleBuffer& other) const {
+        return count == other.count && std::equal(cur(), cur() + count, other.cur());
+    }
+
+   private:
+    HugeVector<T> arena;
+    size_t count = 0, a = 0, b = 0;
+};
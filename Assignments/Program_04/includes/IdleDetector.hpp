@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "GridView.hpp"
+
+// --------------------------------------------------------------
+// IdleDetector:
+// --------------------------------------------------------------
+// Notices when a run has settled into a still life or a cycle of
+// at most maxPeriod generations, so the main loop can stop stepping
+// and redrawing a board that will never change again.
+//
+// observe() is called after every step with a view of the new
+// board (any GridView format; only boards of a candidate cycle are
+// copied, to replay them). It keeps
+// a 64-bit hash of each of the last maxPeriod boards; when the
+// newest hash matches the one p generations back, p is a candidate
+// period. A candidate that keeps matching for 'confirm' whole cycles
+// becomes the period, and the p boards of one cycle are kept so the
+// display can replay them without the engine. The last board of the
+// confirmation is compared cell for cell with its copy one period
+// earlier, so a hash collision cannot put a live board to sleep.
+//
+// Anything that changes the board other than step() (edits, undo,
+// restore, rule changes) must call reset().
+// --------------------------------------------------------------
+class IdleDetector {
+   public:
+    using Grid = std::vector<std::vector<int>>;
+
+    explicit IdleDetector(int maxPeriod = 8, int confirm = 2);
+
+    // Board after a step, at 'generation'. Returns the period once
+    // the board is confirmed periodic (1 = still life), else 0.
+    int observe(const GridView& grid, uint64_t generation);
+
+    void reset();
+
+    int period() const { return confirmed; }
+
+    // One cycle, cycle()[i] being the board at generation
+    // cycleStart() + i (and every period() generations later).
+    const std::vector<Grid>& cycle() const { return frames; }
+    uint64_t cycleStart() const { return start; }
+
+    // The board at any generation >= cycleStart().
+    const Grid& boardAt(uint64_t generation) const { return frames[(generation - start) % frames.size()]; }
+
+    static uint64_t hash(const GridView& grid);
+
+   private:
+    int maxPeriod, confirm;
+    std::vector<uint64_t> hashes;  // ring, indexed by generation % maxPeriod+1
+    uint64_t seen = 0;             // boards observed since reset()
+
+    int candidate = 0;     // period being confirmed
+    uint64_t matched = 0;  // consecutive generations it has held
+    std::vector<Grid> frames;
+    uint64_t start = 0;
+    int confirmed  = 0;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// --------------------------------------------------------------
+// LifeRule:
+// --------------------------------------------------------------
+// A "Life-like" rule in B/S notation, e.g. "B3/S23" for Conway,
+// "B36/S23" for HighLife, "B2/S" for Seeds.
+//
+// Bit n of 'birth'   set → a dead cell with n neighbors is born.
+// Bit n of 'survive' set → a live cell with n neighbors survives.
+// --------------------------------------------------------------
+struct LifeRule {
+    uint16_t birth   = 1 << 3;
+    uint16_t survive = (1 << 2) | (1 << 3);
+
+    // Next state of a cell given its state and live-neighbor count.
+    int next(int alive, int neighbors) const {
+        return ((alive ? survive : birth) >> neighbors) & 1;
+    }
+
+    // ----------------------------------------------------------
+    // parse("B3/S23"): case-insensitive, either order. Throws
+    // std::invalid_argument on anything else.
+    // ----------------------------------------------------------
+    static LifeRule parse(const std::string& text) {
+        LifeRule rule;
+        rule.birth = rule.survive = 0;
+        uint16_t* target          = nullptr;
+        bool sawB = false, sawS = false;
+
+        for (char ch : text) {
+            char c = (char)std::toupper((unsigned char)ch);
+            if (c == 'B') {
+                target = &rule.birth;
+                sawB   = true;
+            } else if (c == 'S') {
+                target = &rule.survive;
+                sawS   = true;
+            } else if (c >= '0' && c <= '8' && target) {
+                *target |= 1 << (c - '0');
+            } else if (c != '/') {
+                throw std::invalid_argument("bad rule '" + text + "', expected e.g. B3/S23");
+            }
+        }
+        if (!sawB || !sawS) {
+            throw std::invalid_argument("bad rule '" + text + "', expected e.g. B3/S23");
+        }
+        return rule;
+    }
+
+    std::string toString() const {
+        std::string s = "B";
+        for (int n = 0; n <= 8; ++n)
+            if (birth >> n & 1)
+                s += char('0' + n);
+        s += "/S";
+        for (int n = 0; n <= 8; ++n)
+            if (survive >> n & 1)
+                s += char('0' + n);
+        return s;
+    }
+};
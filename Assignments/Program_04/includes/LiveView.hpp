@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GridView.hpp"
+
+// --------------------------------------------------------------
+// Live view over POSIX shared memory
+// --------------------------------------------------------------
+// The simulation PUBLISHES its latest generation into a named
+// shared-memory segment; any number of viewer processes ATTACH to
+// it read-only and render whenever they like.
+//
+// Layout of the segment:
+//   [ LiveViewHeader ][ row 0 bits ][ row 1 bits ] ...
+//
+// Cells are bit-packed, 1 bit per cell, least significant bit
+// first, each row padded to a whole number of 64-bit words.
+//
+// Consistency uses a seqlock: the writer makes 'seq' odd while it
+// copies and even when done. Readers retry if 'seq' was odd or
+// changed during their copy. The writer never waits for readers.
+// --------------------------------------------------------------
+struct LiveViewHeader {
+    static constexpr uint32_t MAGIC = 0x4c494645;  // "LIFE"
+
+    std::atomic<uint32_t> magic;  // stored last (release): header valid
+    uint32_t wordsPerRow;
+    int32_t rows;
+    int32_t cols;
+    std::atomic<uint64_t> seq;         // odd while a frame is being written
+    std::atomic<uint64_t> generation;  // generation of the published frame
+};
+
+// --------------------------------------------------------------
+// LiveViewPublisher: owned by the simulation. Creates (and on
+// destruction removes) the segment. A segment of the same name that
+// already exists (another simulation, or one that crashed) is never
+// shared: construction fails, or with replace = true the old one is
+// unlinked first (its viewers keep the stale copy they mapped).
+// --------------------------------------------------------------
+class LiveViewPublisher {
+   public:
+    // 'name' follows shm_open rules, e.g. "/gol".
+    LiveViewPublisher(const std::string& name, int rows, int cols, bool replace = false);
+    ~LiveViewPublisher();
+
+    LiveViewPublisher(const LiveViewPublisher&)            = delete;
+    LiveViewPublisher& operator=(const LiveViewPublisher&) = delete;
+
+    // Copy 'grid' into the segment. O(rows * cols / 64) stores,
+    // never blocks.
+    void publish(const GridView& grid, uint64_t generation);
+
+   private:
+    std::string name;
+    size_t bytes;
+    LiveViewHeader* header;
+    uint64_t* bits;
+};
+
+// --------------------------------------------------------------
+// LiveViewReader: used by viewer processes. Maps the segment
+// PROT_READ, so a buggy viewer cannot corrupt the simulation.
+// --------------------------------------------------------------
+class LiveViewReader {
+   public:
+    explicit LiveViewReader(const std::string& name);
+    ~LiveViewReader();
+
+    LiveViewReader(const LiveViewReader&)            = delete;
+    LiveViewReader& operator=(const LiveViewReader&) = delete;
+
+    int rows() const { return header->rows; }
+    int cols() const { return header->cols; }
+
+    // Take a consistent snapshot. Returns false if nothing has been
+    // published yet, or if no complete frame could be copied within
+    // READ_TIMEOUT (then stalled() is true: the publisher died or
+    // hung mid-frame). 'generation' receives the frame's generation.
+    bool read(std::vector<std::vector<int>>& grid, uint64_t& generation);
+
+    // The last read() gave up on a frame that never completed.
+    bool stalled() const { return stuck; }
+
+    static constexpr std::chrono::milliseconds READ_TIMEOUT{100};
+
+   private:
+    size_t bytes;
+    const LiveViewHeader* header;
+    const uint64_t* bits;
+    std::vector<uint64_t> scratch;  // packed copy taken under the seqlock
+    bool stuck = false;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+// --------------------------------------------------------------
+// MpscQueue<T>:
+// --------------------------------------------------------------
+// Bounded lock-free queue: any number of producer threads, one
+// consumer thread (the engine, between generations).
+//
+// Each slot carries a sequence number that says whose turn it is:
+//   seq == pos        → free, producer with ticket 'pos' may write
+//   seq == pos + 1    → full, consumer at 'pos' may read
+// Producers claim a ticket with one CAS on 'tail'; the consumer
+// owns 'head' outright. Nobody ever takes a lock, so a producer on
+// the UI or control thread can never stall the engine (and vice
+// versa).
+//
+// Capacity is rounded up to a power of two.
+// --------------------------------------------------------------
+template <typename T>
+class MpscQueue {
+   public:
+    explicit MpscQueue(size_t capacity = 1024) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        mask  = cap - 1;
+        slots = std::make_unique<Slot[]>(cap);
+        for (size_t i = 0; i < cap; ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&)            = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // ----------------------------------------------------------
+    // tryPush(): returns false if the queue is full.
+    // ----------------------------------------------------------
+    bool tryPush(T value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& s     = slots[pos & mask];
+            size_t seq  = s.seq.load(std::memory_order_acquire);
+            intptr_t df = (intptr_t)seq - (intptr_t)pos;
+            if (df == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;  // ticket claimed
+            } else if (df < 0) {
+                return false;  // consumer has not freed this slot yet
+            } else {
+                pos = tail.load(std::memory_order_relaxed);  // lost the race
+            }
+        }
+        Slot& s = slots[pos & mask];
+        s.value = std::move(value);
+        s.seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ----------------------------------------------------------
+    // push(): spin (yielding) until there is room. Use only from
+    // threads that are allowed to wait, e.g. the control socket.
+    // ----------------------------------------------------------
+    void push(T value) {
+        while (!tryPush(value)) std::this_thread::yield();
+    }
+
+    // ----------------------------------------------------------
+    // tryPop(): consumer side. Returns false if empty.
+    // ----------------------------------------------------------
+    bool tryPop(T& out) {
+        Slot& s    = slots[head & mask];
+        size_t seq = s.seq.load(std::memory_order_acquire);
+        if (seq != head + 1)
+            return false;
+        out = std::move(s.value);
+        s.seq.store(head + mask + 1, std::memory_order_release);  // free for the next lap
+        ++head;
+        return true;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+   private:
+    struct Slot {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail{0};  // shared by producers
+    alignas(64) size_t head = 0;              // consumer only
+};
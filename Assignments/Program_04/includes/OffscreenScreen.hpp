@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Palette.hpp"
+#include "Screen.hpp"
+
+// --------------------------------------------------------------
+// OffscreenScreen:
+// --------------------------------------------------------------
+// A Screen that draws into a caller-owned RGBA framebuffer instead
+// of a window, so rendering can be benchmarked and regression-tested
+// without a display server or SDL.
+//
+// Pixels are 32 bits, bytes R, G, B, A in memory order; 'stride'
+// is the distance between rows in pixels (>= width). Cells map to
+// pixels exactly as in SdlScreen: cell (row, col) covers the
+// cellSize x cellSize square at (col * cellSize, row * cellSize) and
+// its state picks the color from the palette (mono by default: white
+// on black). Cells past the buffer are clipped.
+//
+// Instead of one rectangle per cell, render() turns each cell row
+// into colors once (states through a 256-entry LUT), widens that to
+// the first pixel row with vector stores, and copies it to the
+// remaining cellSize - 1 pixel rows. Large cells (MERGE_CELL_SIZE
+// and up) are instead filled as SPANS: runs of equal colors, one
+// fill per run.
+//
+// hash() is a 64-bit FNV-1a of the visible pixels (stride padding
+// excluded), for golden-image tests.
+// --------------------------------------------------------------
+class OffscreenScreen : public Screen {
+   public:
+    OffscreenScreen(uint32_t* pixels, int width, int height, int cellSize = 10, int stride = 0);
+
+    void render(const GridView& grid) const override;
+
+    // Byte map (age, activity) through a palette, as SdlScreen does.
+    void renderHeatmap(const GridView& values, const Palette& palette) const;
+
+    void pause(int) const override {}  // nothing to wait for
+
+    // Colors for render(): state → palette entry, as in SdlScreen.
+    void setPalette(const Palette& cellPalette);
+
+    uint64_t hash() const;
+
+    int visibleRows() const { return height / cellSize; }
+    int visibleCols() const { return width / cellSize; }
+
+    // Pack a color into the buffer's byte order.
+    static uint32_t rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
+
+   private:
+    static constexpr int MERGE_CELL_SIZE = 8;
+
+    // Every cell's state through 'lut' (lut[0] is the background):
+    // fill one pixel row per cell row, then copy it down.
+    void drawStates(const GridView& grid, const uint32_t lut[256]) const;
+
+    // Palette packed into the buffer's byte order.
+    static void pack(const Palette& palette, uint32_t lut[256]);
+
+    uint32_t* pixels;
+    int width, height, cellSize, stride;
+    uint32_t cellLut[256];
+};
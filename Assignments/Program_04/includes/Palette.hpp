@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// --------------------------------------------------------------
+// Palette:
+// --------------------------------------------------------------
+// A 256-entry color lookup table (LUT) that turns a per-cell byte
+// (age, activity, ...) into a color with one array access instead
+// of per-cell arithmetic. Entry 0 is the background.
+// --------------------------------------------------------------
+struct Rgb {
+    uint8_t r = 0, g = 0, b = 0;
+};
+
+class Palette {
+   public:
+    const Rgb& operator[](uint8_t value) const { return lut[value]; }
+
+    // ----------------------------------------------------------
+    // Built-in palettes:
+    //   heat : black → red → yellow → white   (activity)
+    //   age  : dark blue → cyan → white      (longevity)
+    //   mono : black, then white for 1..255  (plain alive/dead)
+    //   states: black, white, then a distinct hue per state 2..255
+    //           (multi-state automata: Generations, Wireworld, ...)
+    // ----------------------------------------------------------
+    static Palette heat() {
+        return gradient({{{0, 0, 0}, {200, 0, 0}, {255, 220, 0}, {255, 255, 255}}});
+    }
+    static Palette age() {
+        return gradient({{{0, 0, 0}, {20, 40, 160}, {0, 220, 255}, {255, 255, 255}}});
+    }
+    static Palette mono() {
+        Palette p;
+        for (int i = 1; i < 256; ++i) p.lut[i] = {255, 255, 255};
+        return p;
+    }
+
+    static Palette states() {
+        Palette p;
+        p.lut[1] = {255, 255, 255};
+        for (int i = 2; i < 256; ++i) {
+            // Hues a golden angle apart, so neighbouring states differ.
+            double h = std::fmod((i - 2) * 137.508, 360.0) / 60.0;
+            double x = 1 - std::fabs(std::fmod(h, 2.0) - 1);
+            double rgb[6][3] = {{1, x, 0}, {x, 1, 0}, {0, 1, x}, {0, x, 1}, {x, 0, 1}, {1, 0, x}};
+            const double* c = rgb[(int)h % 6];
+            p.lut[i] = {(uint8_t)(40 + 215 * c[0]), (uint8_t)(40 + 215 * c[1]), (uint8_t)(40 + 215 * c[2])};
+        }
+        return p;
+    }
+
+    static Palette byName(const std::string& name) {
+        if (name == "heat")
+            return heat();
+        if (name == "age")
+            return age();
+        if (name == "mono")
+            return mono();
+        if (name == "states")
+            return states();
+        throw std::invalid_argument("unknown palette '" + name + "' (heat, age, mono, states)");
+    }
+
+   private:
+    // stops[0] is the background; 1..255 ramp linearly through
+    // stops[1], stops[2] and stops[3].
+    static Palette gradient(const std::array<Rgb, 4>& stops) {
+        Palette p;
+        p.lut[0] = stops[0];
+        for (int i = 1; i < 256; ++i) {
+            double t = (i - 1) / 127.0;  // 0..2
+            int k    = std::min((int)t, 1) + 1;
+            double f = t - (k - 1);
+            auto mix = [&](uint8_t a, uint8_t b) { return (uint8_t)(a + (b - a) * f + 0.5); };
+            p.lut[i] = {mix(stops[k].r, stops[k + 1].r), mix(stops[k].g, stops[k + 1].g),
+                        mix(stops[k].b, stops[k + 1].b)};
+        }
+        return p;
+    }
+
+    std::array<Rgb, 256> lut{};
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "CellularAutomaton.hpp"
+#include "json.hpp"
+
+using nlohmann::json;
+
+// --------------------------------------------------------------
+// Pattern files
+// --------------------------------------------------------------
+// Patterns use the same layout as assets/shapes.json:
+//
+//   { "shapes": { "glider": { "size": {"w":3,"h":3},
+//                             "cells": [ {"x":0,"y":-1}, ... ] } } }
+//
+// Cell offsets are relative to the pattern's anchor, so stamping
+// at (row, col) puts cell {x, y} at (row + y, col + x).
+// --------------------------------------------------------------
+
+// --------------------------------------------------------------
+// LoadPatterns(path): read and parse a pattern file. Throws
+// std::runtime_error if the file is missing or has no "shapes".
+// --------------------------------------------------------------
+inline json LoadPatterns(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open pattern file " + path);
+    }
+    json data = json::parse(file);
+    if (!data.contains("shapes") || !data["shapes"].is_object()) {
+        throw std::runtime_error(path + " has no \"shapes\" object");
+    }
+    return data;
+}
+
+// --------------------------------------------------------------
+// stampPattern(): set the cells of shape 'name' alive around
+// (row, col). Cells that land off the board are skipped. Returns
+// false if the shape does not exist.
+// --------------------------------------------------------------
+inline bool stampPattern(CellularAutomaton& automaton, const json& patterns, const std::string& name, int row,
+                         int col) {
+    const json& shapes = patterns["shapes"];
+    if (!shapes.contains(name))
+        return false;
+
+    for (const auto& cell : shapes[name]["cells"]) {
+        automaton.setCell(row + cell["y"].get<int>(), col + cell["x"].get<int>(), 1);
+    }
+    return true;
+}
+
+// --------------------------------------------------------------
+// savePattern(): write the current board as a single-shape pattern
+// file (anchored at the top-left corner), so snapshots can be
+// loaded back with LoadPatterns() + stampPattern().
+// --------------------------------------------------------------
+inline void savePattern(const std::vector<std::vector<int>>& grid, const std::string& name,
+                        const std::string& path) {
+    json cells = json::array();
+    for (size_t r = 0; r < grid.size(); ++r)
+        for (size_t c = 0; c < grid[r].size(); ++c)
+            if (grid[r][c])
+                cells.push_back({{"x", c}, {"y", r}});
+
+    json shape = {{"size", {{"w", grid.empty() ? 0 : grid[0].size()}, {"h", grid.size()}}}, {"cells", cells}};
+    json data  = {{"shapes", {{name, shape}}}};
+
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not write snapshot " + path);
+    }
+    file << data.dump(2) << "\n";
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FrameQueue.hpp"
+#include "GridView.hpp"
+
+struct RecorderStats {
+    uint64_t captured = 0;  // frames handed to the encoder
+    uint64_t dropped  = 0;  // frames skipped because the queue was full
+    uint64_t encoded  = 0;  // frames written out
+    uint64_t bytes    = 0;  // output bytes so far
+};
+
+// --------------------------------------------------------------
+// Recorder:
+// --------------------------------------------------------------
+// Base class for run recordings (video, GIF). The engine calls
+// capture() once per generation; every 'every'-th generation is
+// copied into a frame from a FrameQueue and handed to a worker
+// thread, which calls the subclass's encode(). Encoding, palette
+// lookups and I/O never run on the engine's thread.
+//
+// With lossless = false a full queue drops the frame (counted in
+// stats().dropped) so the engine never waits; with lossless = true
+// the engine waits for a free frame, which is what a headless
+// export wants: every frame, as fast as the encoder can go.
+//
+// Subclasses call start() at the end of their constructor and
+// finish() in their destructor, so the worker never sees a
+// half-built or half-destroyed object.
+// --------------------------------------------------------------
+class Recorder {
+   public:
+    Recorder(int rows, int cols, int every = 1, bool lossless = false, size_t depth = 8);
+    virtual ~Recorder();
+
+    Recorder(const Recorder&)            = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    // Engine side. Live cells become 1, dead cells 0. The view must
+    // be rows x cols (std::invalid_argument otherwise).
+    bool capture(const GridView& grid, uint64_t generation);
+
+    // Engine side, for multi-state boards and byte maps such as
+    // CellularAutomaton::ageView(): every cell's state, as is.
+    bool captureStates(const GridView& grid, uint64_t generation);
+
+    // Encode everything queued, write the trailer, stop the worker.
+    // Throws std::runtime_error if the encoder hit an I/O error.
+    void finish();
+
+    RecorderStats stats() const;
+
+    // ----------------------------------------------------------
+    // openOutput(): "-" is stdout, "|command" pipes into a shell
+    // command (e.g. "|ffmpeg -i - out.mp4"), anything else is a file.
+    // closeOutput() returns false if the write side failed.
+    // ----------------------------------------------------------
+    static FILE* openOutput(const std::string& target);
+    static bool closeOutput(FILE* out, const std::string& target);
+
+   protected:
+    virtual void encode(const Frame& frame) = 0;
+    virtual void close() {}  // after the last frame
+
+    void start();
+
+    // For subclasses: write and count bytes, throw on failure.
+    void write(FILE* out, const void* data, size_t size);
+
+    const int rows, cols;
+
+   private:
+    Frame* slotFor(uint64_t generation);
+    void checkSize(const GridView& grid) const;
+    void run();
+
+    int every;
+    bool lossless;
+    FrameQueue queue;
+    std::thread worker;
+    bool finished = false;
+
+    std::atomic<uint64_t> captured{0}, dropped{0}, encoded{0}, bytes{0};
+    std::mutex errorLock;
+    std::string error;
+};
@@ -0,0 +1,150 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "GridView.hpp"
+
+// --------------------------------------------------------------
+// RenderPolicy:
+// --------------------------------------------------------------
+// Decides, frame by frame, how much drawing the frame budget can
+// afford once the simulation step has been paid for. The step is
+// never skipped, so the simulation keeps its target rate while the
+// display degrades:
+//
+//   Present   full image          step + render        fits
+//   Reduced   level-of-detail     step + reduced render fits
+//             image (factor x factor cells per block)
+//   Skip      nothing drawn       neither fits
+//
+// Costs are exponentially weighted averages of what previous frames
+// actually took, updated through rendered() / stepped(). Time a frame
+// leaves unused is banked (up to one budget, which is what
+// FrameScheduler lets the next frame make up), so a render that
+// does not fit a single frame is still shown whenever the frames
+// skipped before it have saved enough. The LOD
+// factor is the smallest power of two whose estimated cost (full
+// cost / factor^2 until measured) fits, up to maxFactor. At most
+// maxSkip frames in a row are skipped, so the picture never
+// freezes. Costs only change when measured, so while degraded every
+// PROBE-th frame is drawn in full to find out whether the board has
+// become light enough to go back to Present.
+// --------------------------------------------------------------
+class RenderPolicy {
+   public:
+    enum class Decision { Present, Reduced, Skip };
+
+    static constexpr int MAX_LEVELS = 4;  // factors 1, 2, 4, 8
+    static constexpr int PROBE      = 32;
+
+    explicit RenderPolicy(double budgetMs, int maxSkip = 8, int maxFactor = 8)
+        : budgetMs(budgetMs), maxSkip(maxSkip), maxLevel(0) {
+        while (maxLevel + 1 < MAX_LEVELS && (2 << maxLevel) <= maxFactor) ++maxLevel;
+    }
+
+    void setBudget(double ms) { budgetMs = ms; }
+
+    // ----------------------------------------------------------
+    // decide(): what to do with the frame about to be drawn.
+    // factor() is then the LOD factor for a Reduced frame.
+    // ----------------------------------------------------------
+    Decision decide() {
+        Decision d = choose();
+        if (d == Decision::Skip) {
+            ++skipRun;
+            ++skipped;
+        } else {
+            skipRun = 0;
+            if (d == Decision::Reduced)
+                ++reduced;
+        }
+        ++frames;
+        return d;
+    }
+
+    int factor() const { return 1 << level; }
+
+    // Measured costs of the image drawn this frame at 'factor'
+    // (1 = full detail), then of the rest of the frame's work;
+    // stepped() closes the frame.
+    void stepped(double ms) {
+        stepMs  = average(stepMs, ms);
+        credit  = std::clamp(credit + budgetMs - ms - drawnMs, -budgetMs, budgetMs);
+        drawnMs = 0;
+    }
+    void rendered(int factor, double ms) {
+        drawnMs += ms;
+        int l = 0;
+        while ((1 << l) < factor && l + 1 < MAX_LEVELS) ++l;
+        // A level last drawn long ago has a stale average: restart it.
+        renderMs[l] = frames - drawnAt[l] > 1 ? ms : average(renderMs[l], ms);
+        drawnAt[l]  = frames;
+    }
+
+    // ----------------------------------------------------------
+    // reduce(): the level-of-detail image of the top-left rows x
+    // cols of 'grid', one cell per factor x factor block, alive if
+    // any cell of the block is (so sparse objects stay visible).
+    // A bit-packed view tests up to 64 cells of a block at once.
+    // ----------------------------------------------------------
+    static std::vector<std::vector<int>> reduce(const GridView& grid, int factor, int rows, int cols) {
+        rows = std::min(rows, grid.rows());
+        cols = rows ? std::min(cols, grid.cols()) : 0;
+        std::vector<std::vector<int>> blocks((rows + factor - 1) / factor,
+                                             std::vector<int>((cols + factor - 1) / factor, 0));
+        for (size_t br = 0; br < blocks.size(); ++br) {
+            int r = (int)br * factor, h = std::min(factor, rows - r);
+            for (size_t bc = 0; bc < blocks[br].size(); ++bc) {
+                int c = (int)bc * factor;
+                blocks[br][bc] = grid.anyAlive(r, c, h, std::min(factor, cols - c));
+            }
+        }
+        return blocks;
+    }
+
+    uint64_t framesSeen() const { return frames; }
+    uint64_t framesSkipped() const { return skipped; }
+    uint64_t framesReduced() const { return reduced; }
+
+   private:
+    Decision choose() {
+        double left = budgetMs - std::max(stepMs, 0.0) + credit;
+        if (budgetMs <= 0 || estimate(0) <= left || ++sinceFull >= PROBE) {
+            level     = 0;
+            sinceFull = 0;
+            return Decision::Present;
+        }
+        for (int l = 1; l <= maxLevel; ++l) {
+            if (estimate(l) <= left) {
+                level = l;
+                return Decision::Reduced;
+            }
+        }
+        if (skipRun < maxSkip)
+            return Decision::Skip;
+        level = maxLevel;  // overdue: show the cheapest image
+        return maxLevel ? Decision::Reduced : Decision::Present;
+    }
+
+    // Unmeasured levels are guessed from the full-detail cost.
+    double estimate(int l) const {
+        if (renderMs[l] >= 0)
+            return renderMs[l];
+        return renderMs[0] < 0 ? 0 : renderMs[0] / (1 << 2 * l);
+    }
+
+    static double average(double old, double ms) { return old < 0 ? ms : old + (ms - old) / 8; }
+
+    double budgetMs;
+    int maxSkip, maxLevel;
+    int level     = 0;
+    int skipRun   = 0;
+    int sinceFull = 0;  // degraded frames since the last full one
+    double stepMs               = -1;
+    double credit               = 0;  // banked unused time, ms
+    double drawnMs              = 0;  // this frame's render
+    double renderMs[MAX_LEVELS] = {-1, -1, -1, -1};  // -1: not measured yet
+    uint64_t drawnAt[MAX_LEVELS] = {};
+    uint64_t frames = 0, skipped = 0, reduced = 0;
+};
@@ -0,0 +1,377 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DensityPyramid.hpp"
+#include "GridLayer.hpp"
+#include "Palette.hpp"
+#include "RenderPolicy.hpp"
+#include "Screen.hpp"
+#include "View.hpp"
+
+// --------------------------------------------------------------
+// SdlScreen:
+// --------------------------------------------------------------
+// Renders the automaton using SDL2 in a graphical window
+// --------------------------------------------------------------
+class SdlScreen : public Screen {
+   private:
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    int cellSize;
+    int windowWidth;
+    int windowHeight;
+    mutable std::unique_ptr<GridLayer> gridLayer;  // null: no grid lines
+
+    // Extra views (renderViews): one texture per view holding its
+    // last image, and the density pyramid they share.
+    struct ViewCache {
+        SDL_Texture* texture = nullptr;
+        int width = 0, height = 0;  // texels
+        std::vector<uint8_t> shades;
+        std::vector<uint32_t> pixels;
+    };
+    mutable std::vector<ViewCache> viewCache;
+    mutable DensityPyramid pyramid;
+    mutable uint64_t frameCount = 0;
+
+    // Indexed cell image: one byte per visible cell (its state, age
+    // or heat), turned into colors through a palette while it is
+    // copied into a streaming texture, one texel per cell. The GPU
+    // scales it up to cellSize; the number of states or colors
+    // makes no difference to the cost.
+    struct IndexedImage {
+        SDL_Texture* texture = nullptr;
+        int width = 0, height = 0;  // texels (cells)
+        std::vector<uint8_t> indices;
+    };
+    mutable IndexedImage cells;
+    Palette palette = Palette::mono();
+
+    // Bottom layer of the cell views: cached grid lines if enabled,
+    // else the palette's background color
+    void drawBackground() const {
+        if (gridLayer) {
+            gridLayer->draw(renderer, cellSize);
+        } else {
+            SDL_SetRenderDrawColor(renderer, palette[0].r, palette[0].g, palette[0].b, 255);
+            SDL_RenderClear(renderer);
+        }
+    }
+
+    // Size the index buffer for the visible part of a rows x cols board
+    void resizeIndices(int rows, int cols) const {
+        cells.height = std::max(0, std::min(rows, visibleRows() + 1));
+        cells.width  = std::max(0, std::min(cols, visibleCols() + 1));
+        cells.indices.resize((size_t)cells.width * cells.height);
+    }
+
+    // ----------------------------------------------------------
+    // drawIndexed(): map cells.indices through 'lut' straight into
+    // the locked texture and copy it over the background. Entry 0
+    // is transparent, so grid lines show between live cells. The
+    // texture is (re)created only when the visible size changes.
+    // ----------------------------------------------------------
+    void drawIndexed(const Palette& lut) const {
+        if (cells.width == 0 || cells.height == 0)
+            return;
+        uint32_t argb[256];
+        for (int i = 0; i < 256; ++i) {
+            Rgb c   = lut[(uint8_t)i];
+            argb[i] = (i ? 0xFF000000u : 0) | (uint32_t)c.r << 16 | (uint32_t)c.g << 8 | c.b;
+        }
+
+        int w = 0, h = 0;
+        if (cells.texture)
+            SDL_QueryTexture(cells.texture, nullptr, nullptr, &w, &h);
+        if (!cells.texture || w != cells.width || h != cells.height) {
+            if (cells.texture)
+                SDL_DestroyTexture(cells.texture);
+            cells.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                              cells.width, cells.height);
+            if (!cells.texture)
+                return;
+            SDL_SetTextureBlendMode(cells.texture, SDL_BLENDMODE_BLEND);
+        }
+
+        void* raw;
+        int pitch;
+        if (SDL_LockTexture(cells.texture, nullptr, &raw, &pitch) != 0)
+            return;
+        for (int r = 0; r < cells.height; ++r) {
+            uint32_t* out     = (uint32_t*)((uint8_t*)raw + (size_t)r * pitch);
+            const uint8_t* in = &cells.indices[(size_t)r * cells.width];
+            for (int c = 0; c < cells.width; ++c) out[c] = argb[in[c]];
+        }
+        SDL_UnlockTexture(cells.texture);
+
+        SDL_Rect dst = {0, 0, cells.width * cellSize, cells.height * cellSize};
+        SDL_RenderCopy(renderer, cells.texture, nullptr, &dst);
+    }
+
+    // Background and cells (state = palette index), not yet presented
+    void drawGrid(const GridView& grid) const {
+        drawBackground();
+
+        resizeIndices(grid.rows(), grid.cols());
+        for (int r = 0; r < cells.height; ++r)
+            grid.rowStates(r, 0, cells.width, &cells.indices[(size_t)r * cells.width]);
+        drawIndexed(palette);
+    }
+
+    // ----------------------------------------------------------
+    // updateView(): redraw a view's image into its texture. A
+    // zoomed-out view uses the pyramid level whose blocks are about
+    // one pixel; any other view uses the cells. Either way the
+    // image only covers what the viewport shows.
+    // ----------------------------------------------------------
+    void updateView(const GridView& grid, const View& v, ViewCache& vc) const {
+        int level    = v.cellPx < 1 ? DensityPyramid::levelFor(1 / v.cellPx) : 0;
+        double block = (double)(1 << level);  // cells per texel
+        int row0 = (int)std::floor(v.row0 / block), col0 = (int)std::floor(v.col0 / block);
+        int w = std::max(1, (int)std::ceil(v.width / (v.cellPx * block)));
+        int h = std::max(1, (int)std::ceil(v.height / (v.cellPx * block)));
+
+        if (level > 0) {
+            pyramid.shade(level, row0, col0, h, w, vc.shades);
+        } else {
+            vc.shades.assign((size_t)w * h, 0);
+            int c0 = std::max(0, -col0), c1 = std::min(w, grid.cols() - col0);
+            for (int r = std::max(0, -row0); r < h && row0 + r < grid.rows() && c0 < c1; ++r) {
+                uint8_t* line = &vc.shades[(size_t)r * w];
+                grid.rowAlive(row0 + r, col0 + c0, c1 - c0, line + c0);
+                for (int c = c0; c < c1; ++c) line[c] *= 255;
+            }
+        }
+
+        // Shade -> ARGB: dark blue-gray background up to white.
+        vc.pixels.resize(vc.shades.size());
+        for (size_t i = 0; i < vc.shades.size(); ++i) {
+            uint32_t k   = vc.shades[i];
+            uint32_t rg  = 20 + k * 235 / 255, b = 28 + k * 227 / 255;
+            vc.pixels[i] = 0xFF000000u | rg << 16 | rg << 8 | b;
+        }
+
+        if (!vc.texture || vc.width != w || vc.height != h) {
+            if (vc.texture)
+                SDL_DestroyTexture(vc.texture);
+            vc.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, w, h);
+            vc.width   = w;
+            vc.height  = h;
+        }
+        if (vc.texture)
+            SDL_UpdateTexture(vc.texture, nullptr, vc.pixels.data(), w * 4);
+    }
+
+   public:
+    // Constructor: creates SDL window and renderer. vsync=true asks
+    // for a renderer whose present() waits for the display refresh;
+    // resizable=true lets the user resize the window (see resize()).
+    SdlScreen(int width, int height, int cellSz = 10, bool vsync = false, bool resizable = false) 
+        : cellSize(cellSz), windowWidth(width), windowHeight(height) 
+    {
+        // Initialize SDL2
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+            throw std::runtime_error("SDL initialization failed");
+        }
+
+        window = SDL_CreateWindow(
+            "Conway's Game of Life",
+            SDL_WINDOWPOS_CENTERED,
+            SDL_WINDOWPOS_CENTERED,
+            width,
+            height,
+            SDL_WINDOW_SHOWN | (resizable ? SDL_WINDOW_RESIZABLE : 0)
+        );
+
+
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0));
+
+    }
+
+    // Render the grid
+    void render(const GridView& grid) const override {
+        drawGrid(grid);
+        SDL_RenderPresent(renderer);
+    }
+
+    // ----------------------------------------------------------
+    // renderViews(): the main view as render() draws it, then each
+    // extra View (minimap, detail window) over it, then one present.
+    //
+    // All views read the same snapshot ('grid' as it is now) and
+    // share one DensityPyramid, built at most once per frame and
+    // only when a zoomed-out view is due. A view's image is drawn
+    // at its own resolution (pyramid blocks or cells, never both),
+    // uploaded to its texture only on the frames it is due, and
+    // scaled into its viewport by the GPU on every frame.
+    // ----------------------------------------------------------
+    void renderViews(const GridView& grid, const std::vector<View>& views) const {
+        drawGrid(grid);
+        if (viewCache.size() != views.size()) {
+            for (auto& vc : viewCache)
+                if (vc.texture)
+                    SDL_DestroyTexture(vc.texture);
+            viewCache.assign(views.size(), ViewCache());
+        }
+
+        bool pyramidBuilt = false;
+        for (size_t i = 0; i < views.size(); ++i) {
+            const View& v = views[i];
+            ViewCache& vc = viewCache[i];
+            bool due      = !vc.texture || frameCount % std::max(1, v.every) == 0;
+            if (due) {
+                if (v.cellPx < 1 && !pyramidBuilt) {
+                    pyramid.build(grid);
+                    pyramidBuilt = true;
+                }
+                updateView(grid, v, vc);
+            }
+
+            SDL_Rect dst = {v.x, v.y, v.width, v.height};
+            if (vc.texture)
+                SDL_RenderCopy(renderer, vc.texture, nullptr, &dst);
+            SDL_SetRenderDrawColor(renderer, 90, 90, 110, 255);
+            SDL_RenderDrawRect(renderer, &dst);
+
+            if (v.showMain) {
+                // The part of the board the main view shows.
+                SDL_Rect seen = {v.x + (int)(-v.col0 * v.cellPx), v.y + (int)(-v.row0 * v.cellPx),
+                                 std::max(1, (int)(visibleCols() * v.cellPx)),
+                                 std::max(1, (int)(visibleRows() * v.cellPx))};
+                SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255);
+                SDL_RenderDrawRect(renderer, &seen);
+            }
+        }
+        ++frameCount;
+        SDL_RenderPresent(renderer);
+    }
+
+    // ----------------------------------------------------------
+    // renderReduced(): level-of-detail view for frames the full
+    // render does not fit in (RenderPolicy). Each factor x factor
+    // block of visible cells becomes one rectangle, alive if any of
+    // its cells is, all drawn with a single SDL_RenderFillRects.
+    // ----------------------------------------------------------
+    void renderReduced(const GridView& grid, int factor) const {
+        drawBackground();
+
+        auto blocks = RenderPolicy::reduce(grid, factor, visibleRows() + 1, visibleCols() + 1);
+        int size    = cellSize * factor;
+        std::vector<SDL_Rect> rects;
+        for (size_t r = 0; r < blocks.size(); ++r)
+            for (size_t c = 0; c < blocks[r].size(); ++c)
+                if (blocks[r][c])
+                    rects.push_back({(int)c * size, (int)r * size, size, size});
+
+        SDL_SetRenderDrawColor(renderer, palette[1].r, palette[1].g, palette[1].b, 255);
+        SDL_RenderFillRects(renderer, rects.data(), (int)rects.size());
+        SDL_RenderPresent(renderer);
+    }
+
+    // ----------------------------------------------------------
+    // renderHeatmap(): draw a per-cell byte map (age, activity; see
+    // CellularAutomaton::ageView()) through a palette LUT. The bytes
+    // already are palette indices, so they go through the same
+    // indexed texture as the cells.
+    // ----------------------------------------------------------
+    void renderHeatmap(const GridView& values, const Palette& heatPalette) const {
+        Rgb bg = heatPalette[0];
+        SDL_SetRenderDrawColor(renderer, bg.r, bg.g, bg.b, 255);
+        SDL_RenderClear(renderer);
+
+        resizeIndices(values.rows(), values.cols());
+        for (int r = 0; r < cells.height; ++r)
+            values.rowStates(r, 0, cells.width, &cells.indices[(size_t)r * cells.width]);
+        drawIndexed(heatPalette);
+
+        SDL_RenderPresent(renderer);
+    }
+
+    // Colors of the cell states (entry 0: background). Takes effect
+    // on the next frame; nothing is rebuilt but the grid-line layer.
+    void setPalette(const Palette& cellPalette) {
+        palette = cellPalette;
+        if (gridLayer)
+            setGridLines(true);
+    }
+
+    // ----------------------------------------------------------
+    // resize(): the window is now width x height pixels (from
+    // SDL_WINDOWEVENT_SIZE_CHANGED). Only the viewport changes here;
+    // the grid-line layer notices the new output size and the view
+    // textures their new viewport on the next frame that draws them,
+    // so a burst of resize events costs nothing until then.
+    // ----------------------------------------------------------
+    void resize(int width, int height) {
+        windowWidth  = std::max(1, width);
+        windowHeight = std::max(1, height);
+    }
+    int width() const { return windowWidth; }
+    int height() const { return windowHeight; }
+
+    // Viewport size in cells: how much of the board is visible
+    int visibleRows() const { return windowHeight / cellSize; }
+    int visibleCols() const { return windowWidth / cellSize; }
+
+    // True if the renderer actually syncs present() to the display
+    // (drivers may ignore the request).
+    bool vsynced() const {
+        SDL_RendererInfo info;
+        return SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+    }
+
+    // Refresh rate of the window's display in Hz, 0 if unknown
+    int refreshRate() const {
+        SDL_DisplayMode mode;
+        int display = SDL_GetWindowDisplayIndex(window);
+        if (display < 0 || SDL_GetCurrentDisplayMode(display, &mode) != 0)
+            return 0;
+        return mode.refresh_rate;
+    }
+
+    // Grid lines between cells, drawn from a cached texture layer
+    void setGridLines(bool on) {
+        gridLayer = on ? std::make_unique<GridLayer>(palette[0], Rgb{40, 40, 48}) : nullptr;
+    }
+
+    // The driver lost render-target contents (SDL_RENDER_TARGETS_RESET)
+    void invalidateLayers() const {
+        if (gridLayer)
+            gridLayer->invalidate();
+    }
+
+    // Replace the window title (used for progress and status text)
+    void setTitle(const std::string& title) const {
+        SDL_SetWindowTitle(window, title.c_str());
+    }
+
+    void pause(int ms) const override {
+        SDL_Delay(ms);
+        
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) {
+                exit(0);
+            }
+        }
+    }
+
+    ~SdlScreen() override {
+        gridLayer.reset();  // its texture belongs to the renderer
+        if (cells.texture)
+            SDL_DestroyTexture(cells.texture);
+        for (auto& vc : viewCache)
+            if (vc.texture)
+                SDL_DestroyTexture(vc.texture);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+    }
+};
\ No newline at end of file
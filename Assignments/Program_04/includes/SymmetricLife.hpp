@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "HugePages.hpp"
+#include "LifeRule.hpp"
+#include "Symmetry.hpp"
+
+// --------------------------------------------------------------
+// SymmetricLife:
+// --------------------------------------------------------------
+// Life engine for symmetric soups that stores and steps only the
+// FUNDAMENTAL DOMAIN: the smallest block of cells from which the
+// symmetry group rebuilds the whole board.
+//
+//   Symmetry  stored block              cells computed per step
+//   None      rows x cols               all
+//   C2        top half                  1/2
+//   D2        left half                 1/2
+//   D4, C4    top-left quadrant         1/4
+//   D8        top-left quadrant         upper triangle, ~1/8
+//
+// The block has a one-cell halo. Before every step the halo (and,
+// for D8, the mirrored lower triangle) is refreshed from the cells
+// they are images of, using a table built once in the constructor.
+// That is the reflection/rotation-aware boundary: neighbors across
+// a mirror line or rotation centre are read from their images, and
+// neighbors off the board read as dead.
+//
+// Results are identical to evolving the full symmetric board with
+// ConwayLife; expand() rebuilds the full board when needed.
+// --------------------------------------------------------------
+class SymmetricLife {
+   public:
+    SymmetricLife(int rows, int cols, Symmetry symmetry, LifeRule rule = LifeRule());
+
+    // Take the domain from a full board (assumed symmetric).
+    void load(const std::vector<std::vector<int>>& grid);
+
+    // Random symmetric soup, drawn directly into the domain.
+    void randomize(double density);
+
+    void step();
+
+    // Rebuild the full rows x cols board.
+    void expand(std::vector<std::vector<int>>& grid) const;
+
+    long population() const;  // of the FULL board
+    uint64_t generation() const { return gen; }
+
+    Symmetry symmetry() const { return sym; }
+    size_t storedCells() const { return cells.size(); }
+    size_t computedCells() const { return computed.size(); }
+
+   private:
+    bool inComputed(int r, int c) const;
+    int sourceOf(int r, int c) const;
+    void refresh(uint8_t* buf) const;
+
+    int rows, cols;
+    Symmetry sym;
+    LifeRule rule;
+    int domRows, domCols;  // fundamental block, without halo
+    int stride;            // domCols + 2
+
+    DoubleBuffer<uint8_t> cells;     // (domRows + 2) x stride each
+    std::vector<int> computed;       // buffer indices updated by step()
+    std::vector<int> refreshDst;     // halo / derived cells ...
+    std::vector<int> refreshSrc;     // ... and where they copy from (-1 = dead)
+    std::vector<uint8_t> weight;     // board cells each computed cell stands for
+    uint64_t gen = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// --------------------------------------------------------------
+// Symmetry groups for soups
+// --------------------------------------------------------------
+// Life rules commute with rotations and reflections, and a bounded
+// board with dead surroundings is itself symmetric about its centre.
+// So a board that starts symmetric stays symmetric forever.
+//
+//   None : no symmetry
+//   C2   : 180° rotation
+//   C4   : 90° rotations (square boards only)
+//   D2   : mirror left ↔ right
+//   D4   : mirror left ↔ right and top ↔ bottom
+//   D8   : all rotations and diagonal mirrors (square boards only)
+// --------------------------------------------------------------
+enum class Symmetry { None, C2, C4, D2, D4, D8 };
+
+inline Symmetry parseSymmetry(const std::string& name) {
+    if (name == "none" || name == "C1")
+        return Symmetry::None;
+    if (name == "C2")
+        return Symmetry::C2;
+    if (name == "C4")
+        return Symmetry::C4;
+    if (name == "D2")
+        return Symmetry::D2;
+    if (name == "D4")
+        return Symmetry::D4;
+    if (name == "D8")
+        return Symmetry::D8;
+    throw std::invalid_argument("unknown symmetry '" + name + "' (none, C2, C4, D2, D4, D8)");
+}
+
+inline const char* symmetryName(Symmetry s) {
+    switch (s) {
+        case Symmetry::C2: return "C2";
+        case Symmetry::C4: return "C4";
+        case Symmetry::D2: return "D2";
+        case Symmetry::D4: return "D4";
+        case Symmetry::D8: return "D8";
+        default: return "none";
+    }
+}
+
+// C4 and D8 map rows onto columns, so they need a square board.
+inline void checkSymmetry(Symmetry s, int rows, int cols) {
+    if ((s == Symmetry::C4 || s == Symmetry::D8) && rows != cols) {
+        throw std::invalid_argument(std::string(symmetryName(s)) + " symmetry needs a square board");
+    }
+}
+
+// --------------------------------------------------------------
+// symmetryImages(): every cell that (r, c) is mapped to by the
+// group, including (r, c) itself. All of them always share a state.
+// --------------------------------------------------------------
+inline std::vector<std::pair<int, int>> symmetryImages(Symmetry s, int rows, int cols, int r, int c) {
+    const int R = rows - 1, C = cols - 1;
+    switch (s) {
+        case Symmetry::C2:
+            return {{r, c}, {R - r, C - c}};
+        case Symmetry::D2:
+            return {{r, c}, {r, C - c}};
+        case Symmetry::D4:
+            return {{r, c}, {r, C - c}, {R - r, c}, {R - r, C - c}};
+        case Symmetry::C4:
+            return {{r, c}, {c, R - r}, {R - r, C - c}, {C - c, r}};
+        case Symmetry::D8:
+            return {{r, c}, {c, R - r}, {R - r, C - c}, {C - c, r}, {c, r}, {r, C - c}, {R - r, c}, {C - c, R - r}};
+        default:
+            return {{r, c}};
+    }
+}
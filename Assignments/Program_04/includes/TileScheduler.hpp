@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// --------------------------------------------------------------
+// TileScheduler:
+// --------------------------------------------------------------
+// Runs one batch of independent tasks (tile indices, say the active
+// tiles of one generation) on a fixed pool of threads, and returns
+// when all of them are done: run() is the generation barrier.
+//
+// Every worker has its own deque. run() deals the task list out in
+// contiguous slices, one per worker, so neighbouring tiles stay on
+// one core. A worker takes its own tasks from the back of its deque
+// and, once it is empty, steals from the FRONT of the others' (the
+// tasks their owners would reach last), starting at a different
+// victim each time. A region that is much busier than the rest
+// therefore ends up spread over every worker, while an even load
+// causes almost no stealing.
+//
+// The calling thread is worker 0, so TileScheduler(1) runs every
+// task inline with no threads at all. Deques are short and each
+// task costs microseconds, so they are plain mutex-protected
+// std::deques; the locks are almost never contended.
+//
+// NUMA: given a cpu per worker, every worker is pinned to its cpu
+// and thieves try workers on their own node before crossing to
+// another. The caller (often the UI thread) is only pinned to
+// worker 0's cpu while it is inside run() or each(); its own
+// affinity is restored on the way out. setHomes() queues every task on a
+// fixed worker instead of slicing the list, so the same tile runs
+// on the same core every generation unless it is stolen, and each()
+// runs one call on every worker, e.g. to first-touch its memory.
+// --------------------------------------------------------------
+class TileScheduler {
+   public:
+    struct Stats {
+        uint64_t batches = 0;
+        uint64_t tasks   = 0;
+        uint64_t steals  = 0;
+        std::vector<uint64_t> perWorker;  // tasks each worker ran
+    };
+
+    // cpus: empty, or one cpu per worker to pin it to (see
+    // parseAffinity()).
+    explicit TileScheduler(int threads, std::vector<int> cpus = {});
+    ~TileScheduler();
+
+    TileScheduler(const TileScheduler&)            = delete;
+    TileScheduler& operator=(const TileScheduler&) = delete;
+
+    // fn(task, worker) for every entry of 'tasks'; fn must be safe to
+    // call concurrently for different tasks. Not reentrant.
+    void run(const std::vector<int>& tasks, const std::function<void(int task, int worker)>& fn);
+
+    // fn(worker) once on each worker, on that worker; no stealing.
+    void each(const std::function<void(int worker)>& fn);
+
+    // Queue each task on worker home(task) % threads() from now on;
+    // nullptr goes back to contiguous slices.
+    void setHomes(std::function<int(int task)> home);
+
+    int threads() const { return (int)queues.size(); }
+    int cpuOf(int worker) const { return queues[worker]->cpu; }    // -1: not pinned
+    int nodeOf(int worker) const { return queues[worker]->node; }  // 0 if unknown
+
+    // --------------------------------------------------------------
+    // parseAffinity(spec, threads): the cpu of each worker.
+    //   ""        no pinning
+    //   compact   worker w on cpu w (fill one socket first)
+    //   scatter   round-robin over the NUMA nodes
+    //   0,8,1,9   explicit list, one cpu per worker
+    // Only cpus this process may run on are accepted.
+    // --------------------------------------------------------------
+    static std::vector<int> parseAffinity(const std::string& spec, int threads);
+
+    // NUMA node of a cpu (from sysfs); 0 where there is no NUMA.
+    static int nodeOfCpu(int cpu);
+
+    // Counters since construction (read between batches). Tasks not
+    // stolen ran on the worker they were queued on.
+    Stats stats() const;
+
+   private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<int> tasks;
+        uint64_t ran = 0, stole = 0;  // owner's counters
+        int cpu = -1, node = 0;
+        std::vector<int> victims;     // same node first
+    };
+
+    bool take(int worker, int& task);  // own back, else steal
+    void drain(int worker);
+    void loop(int worker);
+    void dispatch();  // run the queued batch: wake the pool, drain, wait
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> pool;  // workers 1..n-1
+
+    // Current batch
+    const std::function<void(int, int)>* job = nullptr;
+    std::atomic<int> remaining{0};
+    bool stealing = true;
+    std::function<int(int)> home;
+    uint64_t batches = 0;
+
+    // Wakes the pool for a batch and the caller when it is done
+    std::mutex gate;
+    std::condition_variable start, done;
+    uint64_t epoch = 0;  // batch number the pool should work on
+    int active     = 0;  // pool workers still inside the batch
+    bool stopping  = false;
+};
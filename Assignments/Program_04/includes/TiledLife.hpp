@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "TileScheduler.hpp"
+
+// --------------------------------------------------------------
+// TiledLife:
+// --------------------------------------------------------------
+// ConwayLife stepped TILE x TILE cells at a time (the tiles the
+// base class already tracks edits in), on a TileScheduler.
+//
+// Only ACTIVE tiles are computed: a tile is active if it or one of
+// its 8 neighbours changed in the previous generation, or was
+// edited since (the base class's dirty flags, which step()
+// consumes). Every other tile cannot change. The board is double
+// buffered, and an inactive tile's cells in the back buffer are
+// already equal to the current ones (it did not change last
+// generation), so swapping the buffers needs no copying either.
+// Once a soup settles, most of the board costs nothing per step.
+//
+// Each task reads the current buffer and writes only its own tile
+// of the back buffer and its own change flag and counts, so tasks
+// need no locks; TileScheduler::run() is the barrier between
+// generations. Results are identical to ConwayLife::step(); with
+// the heatmap enabled it simply falls back to it.
+//
+// NUMA mode (numa = true, best with a cpu per thread): each worker
+// owns a fixed band of tile rows. Tiles are queued on their owner
+// every generation, and the rows of both buffers are reallocated
+// and first touched by their owner whenever the board is set up
+// (or resized), so their pages sit on the owner's node. Only stolen
+// tiles read remote memory.
+// --------------------------------------------------------------
+class TiledLife : public ConwayLife {
+   public:
+    // cpus: one per thread to pin workers to, or empty (see
+    // TileScheduler::parseAffinity()).
+    TiledLife(int r, int c, int threads = 1, bool numa = false, std::vector<int> cpus = {});
+
+    void step() override;
+
+    int threadCount() const { return scheduler.threads(); }
+
+    // Tiles computed by the last step(), and in total.
+    int activeTiles() const { return (int)active.size(); }
+    const std::vector<int>& activeList() const { return active; }
+    int tileCount() const { return tileRows * tileCols; }
+
+    TileScheduler::Stats schedulerStats() const { return scheduler.stats(); }
+    const TileScheduler& getScheduler() const { return scheduler; }
+
+    bool numaAware() const { return numa; }
+    // NUMA mode: the tile rows [first, second) a worker owns, and
+    // the owner of a tile row / tile. Always consistent.
+    std::pair<int, int> bandOf(int worker) const;
+    int ownerOfRow(int tileRow) const;
+    int ownerOfTile(int tile) const;
+
+   private:
+    struct TileResult {
+        long born = 0, died = 0;
+        bool changed = false;
+    };
+
+    void sync();  // back buffer and flags after edits or a resize
+    void computeTile(int tile);
+    void place();  // NUMA mode: owners allocate and touch their rows
+
+    TileScheduler scheduler;
+    bool numa;
+    std::vector<std::vector<int>> back;  // next generation
+    int tileRows = 0;
+    std::vector<uint8_t> changed;        // per tile, last generation
+    std::vector<TileResult> results;     // per tile, this generation
+    std::vector<int> active;
+    std::vector<int> zeros;              // dead row beyond the edges
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Palette.hpp"
+#include "Recorder.hpp"
+
+// --------------------------------------------------------------
+// VideoExporter:
+// --------------------------------------------------------------
+// Writes a run as an uncompressed video stream:
+//
+//   y4m : YUV4MPEG2, 4:2:0, which ffmpeg/x264/mpv read directly
+//   ppm : back-to-back binary PPM (P6) images, one per frame
+//         (ffmpeg -f image2pipe -c:v ppm -i -)
+//
+// Each cell becomes a scale x scale block colored through
+// 'palette'. Output goes to a file, stdout ("-") or a pipe
+// ("|ffmpeg ..."), see Recorder::openOutput(). The conversion
+// and the writes happen on the Recorder's worker thread.
+//
+// Y4M frames need even dimensions; odd ones are padded with the
+// palette's background color.
+// --------------------------------------------------------------
+class VideoExporter : public Recorder {
+   public:
+    enum class Format { Y4M, PPM };
+
+    static Format parseFormat(const std::string& name);
+
+    VideoExporter(const std::string& target, Format format, int rows, int cols, int scale = 2,
+                  const Palette& palette = Palette::mono(), int fps = 30, int every = 1, bool lossless = false);
+    ~VideoExporter() override;
+
+    int width() const { return frameWidth; }
+    int height() const { return frameHeight; }
+
+   protected:
+    void encode(const Frame& frame) override;
+    void close() override;
+
+   private:
+    void encodeY4M(const Frame& frame);
+    void encodePPM(const Frame& frame);
+
+    // Palette index of pixel (x, y); padding reads as 0.
+    const uint8_t* pixelRow(const Frame& frame, int y);
+
+    std::string target;
+    Format format;
+    int scale;
+    Palette palette;
+    int frameWidth, frameHeight;
+    FILE* out = nullptr;
+
+    std::array<uint8_t, 256> lumaOf{}, cbOf{}, crOf{};  // palette → Y'CbCr
+    std::vector<uint8_t> indexRow;                      // one pixel row of palette indices
+    std::vector<uint8_t> plane;                         // output staging buffer
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <algorithm>
+
+// --------------------------------------------------------------
+// View:
+// --------------------------------------------------------------
+// One extra viewport onto the board, drawn over the main view by
+// SdlScreen::renderViews(): a minimap, a zoomed detail window, ...
+//
+//   x, y, width, height   where on the window, in pixels
+//   row0, col0            board cell at the viewport's top-left
+//   cellPx                pixels per cell; below 1 the view is
+//                         zoomed out and reads the density pyramid
+//   every                 redraw every N-th frame; in between the
+//                         cached image is reused, so a minimap at
+//                         every = 4 costs a quarter of a redraw
+//   showMain              outline the main view's footprint
+// --------------------------------------------------------------
+struct View {
+    int x = 0, y = 0, width = 0, height = 0;
+    double row0 = 0, col0 = 0;
+    double cellPx = 1;
+    int every     = 1;
+    bool showMain = false;
+
+    // Fit a rows x cols board into a box of at most maxWidth x
+    // maxHeight pixels whose bottom-right corner is at (right, bottom).
+    static View overview(int rows, int cols, int maxWidth, int maxHeight, int right, int bottom, int every = 4) {
+        View v;
+        v.cellPx   = rows && cols ? std::min((double)maxWidth / cols, (double)maxHeight / rows) : 1;
+        v.width    = std::max(1, (int)(cols * v.cellPx));
+        v.height   = std::max(1, (int)(rows * v.cellPx));
+        v.x        = right - v.width;
+        v.y        = bottom - v.height;
+        v.every    = every;
+        v.showMain = true;
+        return v;
+    }
+};
@@ -5,7 +5,14 @@
 
 using nlohmann::json;
 
-json ArgsToJson(int argc, char* argv[]) {
+// --------------------------------------------------------------
+// ArgsToJson:
+// Turns "key=value" command-line arguments into a JSON object.
+// Values are parsed as JSON when possible (numbers, true/false,
+// arrays); anything else is kept as a plain string, so
+// `suite=distributed` works without shell quoting.
+// --------------------------------------------------------------
+inline json ArgsToJson(int argc, char* argv[]) {
     json params = json::object();
 
     for (int i = 1; i < argc; ++i) {
@@ -17,8 +24,11 @@ json ArgsToJson(int argc, char* argv[]) {
 
         std::string key{arg.substr(0, separator)};
         std::string value{arg.substr(separator + 1)};
-        params[key] = json::parse(value);
+        params[key] = json::parse(value, nullptr, false);
+        if (params[key].is_discarded()) {
+            params[key] = value;  // not valid JSON → treat as a string
+        }
     }
 
     return params;
-}
\ No newline at end of file
+}
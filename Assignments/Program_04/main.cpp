@@ -1,16 +1,31 @@
 #include <sys/ioctl.h>
 #include <unistd.h>  // For STDOUT_FILENO
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <SDL2/SDL.h>
 
 // Project headers
 #include "./includes/AutomatonUtils.hpp"
 #include "./includes/ConwayLife.hpp"
-#include "./includes/Screen.hpp"
+#include "./includes/SdlScreen.hpp"
 #include "./includes/argsToJson.hpp"
 #include "./includes/json.hpp"
 #include "./includes/CellularAutomaton.hpp"
 #include "./includes/Click.hpp"
+#include "./includes/LiveView.hpp"
+#include "./includes/ControlServer.hpp"
+#include "./includes/Patterns.hpp"
+#include "./includes/EditQueue.hpp"
+#include "./includes/Engine.hpp"
+#include "./includes/History.hpp"
+#include "./includes/HugePages.hpp"
+#include "./includes/IdleDetector.hpp"
+#include "./includes/VideoExporter.hpp"
+#include "./includes/GifRecorder.hpp"
+#include "./includes/FrameScheduler.hpp"
+#include "./includes/RenderPolicy.hpp"
+#include "./includes/TiledLife.hpp"
 
 using namespace std;
 using nlohmann::json;
@@ -20,7 +35,22 @@ using nlohmann::json;
 // These values are applied *only if* the user does not provide
 // command-line overrides of the form key=value.
 // --------------------------------------------------------------
-json defaults = {{"width", 800}, {"height", 600}, {"generations", 1000}, {"cellSize", 10}, {"frameDelayMs", 500}};
+json defaults = {{"width", 800},     {"height", 600},        {"generations", 1000},
+                 {"cellSize", 10},   {"frameDelayMs", 500},  {"liveView", ""}, {"liveViewReplace", false},
+                 {"headless", false}, {"control", ""},       {"patterns", "assets/shapes.json"},
+                 {"historyMB", 64},  {"jump", 0},            {"lookahead", 50},
+                 {"symmetry", "none"}, {"heatmap", "off"},
+                 {"export", ""},     {"exportFormat", "y4m"}, {"exportEvery", 1},
+                 {"exportScale", 2}, {"exportSource", "cells"}, {"exportFps", 30},
+                 {"exportFrames", 0}, {"gif", ""},        {"gifScale", 1},
+                 {"gifDelay", 4},     {"gifDisposal", "keep"}, {"fps", 0},
+                 {"vsync", false},    {"frameSkip", true},   {"maxSkip", 8},
+                 {"maxLod", 8},       {"gridLines", false},
+                 {"minimap", false},  {"minimapEvery", 4},
+                 {"idle", true},      {"idlePeriod", 8},     {"idleWaitMs", 250},
+                 {"resizable", true}, {"worldResize", "grow"}, {"palette", "mono"},
+                 {"engine", ""},      {"observeEvery", 100}, {"threads", 1},
+                 {"numa", false},     {"affinity", ""},      {"hugePages", "off"}};
 
 int main(int argc, char* argv[]) {
 
@@ -41,79 +71,699 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    cout << "Simulation Parameters:\n"
+    // ----------------------------------------------------------
+    // export=- or gif=- writes the recording to stdout, so the rest
+    // of main's output (this dump, progress, summaries) goes to
+    // stderr instead and cannot end up inside the byte stream.
+    // ----------------------------------------------------------
+    const bool exportToStdout = params["export"] == "-", gifToStdout = params["gif"] == "-";
+    if (exportToStdout && gifToStdout) {
+        throw std::invalid_argument("export=- and gif=- cannot both write to stdout");
+    }
+    std::ostream& out = exportToStdout || gifToStdout ? std::cerr : std::cout;
+
+    out << "Simulation Parameters:\n"
          << params.dump(4)  // pretty-printed JSON
          << endl;
 
     // ----------------------------------------------------------
-    // Determine the terminal window size.
-    // Using ioctl() with TIOCGWINSZ retrieves:
-    //   - number of character rows (w.ws_row)
-    //   - number of character columns (w.ws_col)
+    // SdlScreen implements the Screen interface in an SDL2 window.
+    // headless=true skips it entirely (servers, batch runs); the
+    // control socket and live view are then the only way in.
+    // gridLines=true (or the G key) draws lines between cells.
+    // resizable=true lets the window be resized (see below).
+    // ----------------------------------------------------------
+    const bool headless = params["headless"];
+    bool gridLines      = params["gridLines"];  // G toggles
+    const int cellSize  = params["cellSize"];
+    std::unique_ptr<SdlScreen> screen;
+    if (!headless) {
+        screen = std::make_unique<SdlScreen>(params["width"], params["height"], cellSize, params["vsync"],
+                                             params["resizable"]);
+        screen->setGridLines(gridLines);
+    }
+
+    // ----------------------------------------------------------
+    // Construct a ConwayLife automaton based on available space.
     //
-    // This allows the simulation to scale to the user's terminal.
+    // In a window the board is exactly what the window shows.
+    // Headless, it is sized from the terminal: ioctl() with
+    // TIOCGWINSZ gives the character rows and columns. Columns are
+    // divided by 2 because each printed cell uses two characters
+    // ("⬜" or two spaces), and 1 row is left so the output does not
+    // scroll. Without a terminal (e.g. under a service manager) the
+    // window parameters are used instead.
     // ----------------------------------------------------------
-    struct winsize w;
-    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0) {
-        std::cout << "Terminal rows:    " << w.ws_row << std::endl;
-        std::cout << "Terminal columns: " << w.ws_col << std::endl;
+    int boardRows, boardCols;
+    struct winsize w = {};
+    if (screen) {
+        boardRows = screen->visibleRows();
+        boardCols = screen->visibleCols();
+    } else if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0) {
+        out << "Terminal rows:    " << w.ws_row << std::endl;
+        out << "Terminal columns: " << w.ws_col << std::endl;
+        boardRows = w.ws_row - 1;
+        boardCols = w.ws_col / 2;
     } else {
         std::cerr << "Error getting terminal size." << std::endl;
+        boardRows = params["height"].get<int>() / cellSize;
+        boardCols = params["width"].get<int>() / cellSize;
+    }
+    // hugePages=thp|2M|1G backs the bit-packed buffers and History's
+    // frames with huge pages, falling back when the system has none.
+    const json& pages = params["hugePages"];
+    HugePages::request(HugePages::parse(pages.is_string() ? pages.get<std::string>() : pages.dump()));
+
+    // Steps only the tiles near last generation's changes, spread
+    // over threads=N workers (see TiledLife). numa=true gives each
+    // worker its own rows; affinity=compact|scatter|0,8,... pins them.
+    const int threads     = params["threads"];
+    const json& affinity  = params["affinity"];  // affinity=3 parses as a number
+    TiledLife gol(boardRows, boardCols, threads, params["numa"].get<bool>(),
+                  TileScheduler::parseAffinity(affinity.is_string() ? affinity.get<std::string>() : affinity.dump(),
+                                               threads));
+
+    // symmetry=C2|C4|D2|D4|D8 starts from a symmetric soup instead.
+    // The interactive loop still steps the full board (edits can
+    // break the symmetry); headless engine=symmetric steps only the
+    // fundamental domain with SymmetricLife.
+    Symmetry symmetry = parseSymmetry(params["symmetry"].get<std::string>());
+    if (symmetry != Symmetry::None) {
+        gol.randomizeSymmetric(0.25, symmetry);
     }
+    EngineRegistry::add("symmetric", EngineRegistry::symmetric(symmetry));
 
     // ----------------------------------------------------------
-    // TextScreen implements the Screen interface using simple
-    // Unicode/ASCII-based rendering in the terminal.
+    // Optional live view: liveView=/name publishes every generation
+    // into shared memory so `./viewer name=/name` can watch the run
+    // from another process. Publishing never waits for viewers. An
+    // existing segment of that name is an error unless
+    // liveViewReplace=true.
     // ----------------------------------------------------------
-   SdlScreen screen(params["width"], params["height"], params["cellSize"]);
+    std::unique_ptr<LiveViewPublisher> liveView;
+    if (!params["liveView"].get<std::string>().empty()) {
+        liveView = std::make_unique<LiveViewPublisher>(params["liveView"].get<std::string>(), gol.getGrid().size(),
+                                                       gol.getGrid().empty() ? 0 : gol.getGrid()[0].size(),
+                                                       params["liveViewReplace"].get<bool>());
+    }
 
     // ----------------------------------------------------------
-    // Construct a ConwayLife automaton based on available space.
-    //
-    // Terminal columns are divided by 2 because each rendered cell
-    // uses two characters ("⬜" or two spaces). Without dividing,
-    // the grid would overflow horizontally.
-    //
-    // Subtracting 1 row prevents scrolling due to newline behavior.
+    // Patterns for the "stamp" command. A missing file is not
+    // fatal; stamping just reports unknown patterns.
+    // ----------------------------------------------------------
+    json patterns = {{"shapes", json::object()}};
+    try {
+        patterns = LoadPatterns(params["patterns"]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
     // ----------------------------------------------------------
-    ConwayLife gol(w.ws_row - 1, w.ws_col / 2);
+    // Optional control socket: control=/tmp/gol.sock lets other
+    // programs pause/step/steer the run. Commands are queued by
+    // the socket thread and applied here between generations.
+    // ----------------------------------------------------------
+    std::unique_ptr<ControlServer> control;
+    if (!params["control"].get<std::string>().empty()) {
+        control = std::make_unique<ControlServer>(params["control"].get<std::string>());
+    }
 
     // ----------------------------------------------------------
     // Main simulation loop.
-    // This runs indefinitely:
-    //   1. Render current grid
-    //   2. Advance one generation (step)
-    //   3. Pause for a fixed delay
+    // This runs until the window closes or "quit" arrives:
+    //   1. Poll input, apply queued control commands
+    //   2. Render current grid
+    //   3. Advance one generation (step) unless paused
+    //   4. Sleep out the rest of the frame (FrameScheduler)
+    // ----------------------------------------------------------
+    // ----------------------------------------------------------
+    // Mouse painting: press toggles the cell under the cursor and
+    // dragging paints that same value along the path (Bresenham
+    // between successive motion events, so fast strokes have no
+    // gaps). Edits go through the lock-free EditQueue and land in
+    // the grid between generations.
+    // ----------------------------------------------------------
+    EditQueue edits;
+    EditWriter painter(edits);
+    bool painting       = false;
+    CellEdit::Op paintOp = CellEdit::Set;
+    int lastRow = 0, lastCol = 0;
+
+    // ----------------------------------------------------------
+    // Rewind / undo. Every generation and every batch of edits is
+    // recorded as a compressed delta; the oldest history is evicted
+    // once it exceeds historyMB.
+    //   Left arrow → go back one generation (pauses the run)
+    //   U          → undo the last edit or generation
+    // ----------------------------------------------------------
+    History history(gol.getRows(), gol.getCols(), params["historyMB"].get<size_t>() << 20);
+    history.record(gol.getGrid(), gol.getStats().generation);
+    History::Grid restored;
+
+    // ----------------------------------------------------------
+    // Fast-forward: run the engine flat out with rendering suspended.
+    //   jump=N on the command line → start at generation N
+    //   J key                      → jump ahead 'generations' gens
+    // gol.advance() picks the engine's fastest path (bit-packed
+    // stepping + cycle skipping for ConwayLife). Progress shows in
+    // the window title (or on stdout when headless); Esc cancels.
+    // ----------------------------------------------------------
+    bool running = true;
+    auto fastForward = [&](uint64_t n) {
+        auto progress = [&](uint64_t done) {
+            std::string text = "Fast-forward " + std::to_string(100 * done / n) + "% (" + std::to_string(done) +
+                               "/" + std::to_string(n) + ")";
+            if (!screen) {
+                out << "\r" << text << std::flush;
+                return true;
+            }
+            screen->setTitle(text + " - Esc to cancel");
+            SDL_Event ev;
+            while (SDL_PollEvent(&ev)) {
+                if (ev.type == SDL_QUIT)
+                    running = false;
+                if (ev.type == SDL_QUIT || (ev.type == SDL_KEYDOWN && ev.key.keysym.sym == SDLK_ESCAPE))
+                    return false;
+            }
+            return true;
+        };
+
+        uint64_t done = gol.advance(n, progress);
+        history.record(gol.getGrid(), gol.getStats().generation);
+        if (screen)
+            screen->setTitle("Conway's Game of Life");
+        out << (screen ? "" : "\n") << "Fast-forwarded " << done << " generations to generation "
+            << gol.getStats().generation << std::endl;
+    };
+
+    const uint64_t jumpTo = params["jump"];
+    if (jumpTo > gol.getStats().generation)
+        fastForward(jumpTo - gol.getStats().generation);
+
+    // ----------------------------------------------------------
+    // Look-ahead preview (L key): show the visible window as it will
+    // be 'lookahead' generations from now, without advancing the
+    // world. simulateRegion() only evolves the viewport plus its
+    // light cone, so this stays cheap however large the board is.
+    // ----------------------------------------------------------
+    const int lookahead = params["lookahead"];
+    bool preview        = false;
+
+    // ----------------------------------------------------------
+    // Heatmap view (H key cycles off → age → activity): draws each
+    // cell's age or recent activity through a palette instead of
+    // plain alive/dead. heatmap=age|activity starts in that view.
+    // The engine only keeps the buffers while a heatmap is shown.
+    // ----------------------------------------------------------
+    const std::vector<std::string> heatmapModes = {"off", "age", "activity"};
+    size_t heatmapMode =
+        std::find(heatmapModes.begin(), heatmapModes.end(), params["heatmap"].get<std::string>()) - heatmapModes.begin();
+    if (heatmapMode == heatmapModes.size()) {
+        throw std::invalid_argument("heatmap must be off, age or activity");
+    }
+
+    // ----------------------------------------------------------
+    // Video export: export=out.y4m (or "-", or "|ffmpeg ...") records
+    // every exportEvery-th generation as Y4M or PPM frames, encoded
+    // on a background thread. exportSource=age|activity records the
+    // heatmap instead of the cells. Headless runs record every frame
+    // (set frameDelayMs=0 to go faster than real time); windowed runs
+    // drop frames rather than stall the display. exportFrames=N ends
+    // the run after N recorded frames.
     //
-    // ctrl-C exits.
+    // gif=run.gif records an animated GIF the same way (same source,
+    // every and frames settings; gifScale, gifDelay in 1/100 s and
+    // gifDisposal=keep|background|previous). Both can run at once.
+    // ----------------------------------------------------------
+    const std::string exportSource = params["exportSource"];
+    if (exportSource != "cells" && exportSource != "age" && exportSource != "activity") {
+        throw std::invalid_argument("exportSource must be cells, age or activity");
+    }
+    const uint64_t exportFrames = params["exportFrames"];
+    const Palette exportPalette =
+        exportSource == "age" ? Palette::age() : exportSource == "activity" ? Palette::heat() : Palette::mono();
+    // In batch mode (below) the engine's observer already picks every
+    // exportEvery-th generation and the last one, so the recorders
+    // take every frame they are handed.
+    const bool batchMode  = headless && !params["engine"].get<std::string>().empty();
+    const int recordEvery = batchMode ? 1 : params["exportEvery"].get<int>();
+    std::vector<std::unique_ptr<Recorder>> recorders;
+    if (!params["export"].get<std::string>().empty()) {
+        recorders.push_back(std::make_unique<VideoExporter>(
+            params["export"].get<std::string>(), VideoExporter::parseFormat(params["exportFormat"]), gol.getRows(),
+            gol.getCols(), params["exportScale"], exportPalette, params["exportFps"], recordEvery, headless));
+    }
+    if (!params["gif"].get<std::string>().empty()) {
+        recorders.push_back(std::make_unique<GifRecorder>(
+            params["gif"].get<std::string>(), gol.getRows(), gol.getCols(), params["gifScale"], exportPalette,
+            exportSource == "cells" ? 2 : 256, params["gifDelay"],
+            GifRecorder::parseDisposal(params["gifDisposal"]), recordEvery, headless));
+    }
+    // Flushes every recorder; an I/O error is reported and makes the
+    // run exit non-zero.
+    auto finishRecorders = [&] {
+        bool ok = true;
+        for (auto& rec : recorders) {
+            try {
+                rec->finish();
+            } catch (const std::exception& ex) {
+                std::cerr << ex.what() << std::endl;
+                ok = false;
+            }
+        }
+        return ok;
+    };
+    const bool exportHeatmap = !recorders.empty() && exportSource != "cells";
+    auto syncHeatmap         = [&] {
+        bool wanted = heatmapMode != 0 || exportHeatmap;
+        if (wanted != gol.heatmapEnabled())
+            gol.enableHeatmap(wanted);
+    };
+    syncHeatmap();
+    const Palette agePalette = Palette::age(), heatPalette = Palette::heat();
+
+    // ----------------------------------------------------------
+    // Cell colors: each state is a palette index (see Palette.hpp).
+    // palette=mono|states|age|heat picks the start, P cycles them;
+    // switching is instant, the next frame just maps through it.
+    // ----------------------------------------------------------
+    const std::vector<std::string> paletteNames = {"mono", "states", "age", "heat"};
+    size_t paletteIndex =
+        std::find(paletteNames.begin(), paletteNames.end(), params["palette"].get<std::string>()) - paletteNames.begin();
+    if (paletteIndex == paletteNames.size()) {
+        throw std::invalid_argument("palette must be mono, states, age or heat");
+    }
+    if (screen)
+        screen->setPalette(Palette::byName(paletteNames[paletteIndex]));
+
+    // ----------------------------------------------------------
+    // Frame pacing: fps=N targets N frames per second (default:
+    // one frame per frameDelayMs; both 0 runs flat out). Each frame
+    // sleeps only for what its work left of the budget, and input
+    // is polled right after the sleep. vsync=true lets the display
+    // pace the loop when the target is its refresh rate or more.
+    // The phase timings and missed frames are printed at exit.
+    // ----------------------------------------------------------
+    const double frameDelayMs = params["frameDelayMs"];
+    double fps                = params["fps"];
+    if (fps <= 0 && frameDelayMs > 0)
+        fps = 1000.0 / frameDelayMs;
+    FrameScheduler scheduler(fps);
+    if (screen && screen->vsynced() && screen->refreshRate() > 0 && (fps <= 0 || fps >= screen->refreshRate() - 1)) {
+        scheduler.setFps(screen->refreshRate());
+        scheduler.setVsyncPaced(true);
+    }
+
+    // ----------------------------------------------------------
+    // Frame skipping: when stepping plus drawing no longer fits the
+    // frame budget, RenderPolicy draws a reduced level-of-detail
+    // image (up to maxLod x maxLod cells per block) or skips drawing
+    // (at most maxSkip frames in a row) so the simulation keeps its
+    // rate. frameSkip=false always draws in full. Once a second the
+    // window title shows the displayed and skipped frame rates and
+    // the simulation rate achieved.
+    // ----------------------------------------------------------
+    const bool frameSkip = params["frameSkip"];
+    RenderPolicy renderPolicy(fps > 0 ? scheduler.periodMs() : 0, params["maxSkip"], params["maxLod"]);
+    auto hudTime     = FrameScheduler::Clock::now();
+    uint64_t hudGen  = gol.getStats().generation;
+    uint64_t hudSeen = 0, hudSkipped = 0;
+    std::string hud;
+    // ----------------------------------------------------------
+    // Idle: once the board is a still life or repeats with a period
+    // of at most idlePeriod generations (IdleDetector), the engine
+    // stops stepping. A cycle is replayed from the cached boards; a
+    // still life is not even redrawn, and the loop blocks in
+    // SDL_WaitEventTimeout (or sleeps, headless) for up to
+    // idleWaitMs at a time. Any key, click or control command wakes
+    // the run: the engine is moved to the generation the replay had
+    // reached and stepping resumes. Heatmaps and recordings change
+    // every generation, so they keep the run awake. idle=false
+    // turns this off.
+    // ----------------------------------------------------------
+    const bool idleEnabled = params["idle"] && recorders.empty();
+    const int idleWaitMs   = params["idleWaitMs"];
+    IdleDetector idle(params["idlePeriod"]);
+    uint64_t idleGen = 0;     // generation the replay has reached
+    bool redraw      = true;  // a still life needs one more frame
+
+    auto updateTitle = [&] {
+        std::string title = "Conway's Game of Life";
+        if (idle.period() == 1)
+            title += " - idle (still life)";
+        else if (idle.period())
+            title += " - idle (period " + std::to_string(idle.period()) + ")";
+        if (preview)
+            title += " - preview +" + std::to_string(lookahead);
+        if (heatmapMode)
+            title += " - " + heatmapModes[heatmapMode];
+        else if (paletteIndex)
+            title += " - " + paletteNames[paletteIndex] + " palette";
+        screen->setTitle(hud.empty() ? title : title + " | " + hud);
+    };
+
+    // Leave idle (the engine catches up with the replay), and start
+    // detection over: input may change the board.
+    auto wake = [&] {
+        bool wasIdle = idle.period() != 0;
+        if (wasIdle && idleGen != gol.getStats().generation) {
+            gol.restore(idle.boardAt(idleGen), idleGen);
+            history.record(gol.getGrid(), idleGen);
+        }
+        idle.reset();
+        if (wasIdle) {
+            redraw = true;
+            if (screen)
+                updateTitle();
+        }
+    };
+
+    // ----------------------------------------------------------
+    // Minimap (minimap=true, M toggles): an overview of the whole
+    // board in the bottom-right corner, drawn from the density
+    // pyramid and refreshed every minimapEvery frames, with the main
+    // view's footprint outlined. More View entries (detail windows)
+    // render the same way from the same snapshot.
+    // ----------------------------------------------------------
+    bool minimap = params["minimap"];
+    std::vector<View> views;
+    auto layoutViews = [&] {
+        int width = screen->width(), height = screen->height();
+        views.assign(1, View::overview(gol.getRows(), gol.getCols(), width / 4, height / 4, width - 8, height - 8,
+                                       params["minimapEvery"]));
+    };
+    if (screen)
+        layoutViews();
+
+    // ----------------------------------------------------------
+    // Window resize (resizable=true): the viewport always follows
+    // the window. worldResize=grow also grows the board to cover it
+    // (it never shrinks, so nothing is lost by making the window
+    // smaller again), fit makes the board match the window (cells
+    // outside are dropped), off keeps the board as it is. The board
+    // is resized in place (CellularAutomaton::resize), so only the
+    // new cells are allocated. Resize events are coalesced and
+    // applied once per frame, between generations. The board stays
+    // fixed while a live view or a recording is running, since they
+    // were set up for its size; rewind history starts over.
+    // ----------------------------------------------------------
+    const std::string worldResize = params["worldResize"];
+    if (worldResize != "off" && worldResize != "grow" && worldResize != "fit") {
+        throw std::invalid_argument("worldResize must be off, grow or fit");
+    }
+    bool resizePending = false;
+    int resizeWidth = 0, resizeHeight = 0;
+
     // ----------------------------------------------------------
+    // Batch mode: headless=true with engine=NAME (nested, bitpacked,
+    // symmetric; see EngineRegistry) runs 'generations' generations
+    // in a single Engine::run() and exits. The engine loops on its
+    // own kernel and only comes back every observeEvery generations
+    // (every exportEvery while recording) and at the last one to
+    // print progress, publish the live view and feed the recorders. There is no control socket,
+    // painting or history in this mode.
+    // ----------------------------------------------------------
+    const std::string engineName = params["engine"];
+    if (batchMode) {
+        if (exportHeatmap) {
+            throw std::invalid_argument("batch mode (engine=...) records cells only; use exportSource=cells");
+        }
+        auto engine = EngineRegistry::create(engineName, gol.getRows(), gol.getCols(), gol.getRule());
+        engine->load(gol.view(), gol.getStats().generation);
+
+        RunObserver observer;
+        observer.every = recorders.empty() ? params["observeEvery"].get<uint64_t>()
+                                           : params["exportEvery"].get<uint64_t>();
+        observer.frame = [&](uint64_t generation, const GridView& board) {
+            out << "\rGeneration " << generation << ", population " << engine->population() << std::flush;
+            if (liveView)
+                liveView->publish(board, generation);
+            bool more = true;
+            for (auto& rec : recorders) {
+                rec->capture(board, generation);
+                if (exportFrames && rec->stats().captured >= exportFrames)
+                    more = false;
+            }
+            return more;
+        };
+
+        auto began    = FrameScheduler::Clock::now();
+        uint64_t done = engine->run(params["generations"].get<uint64_t>(), observer);
+        double secs   = std::chrono::duration<double>(FrameScheduler::Clock::now() - began).count();
+        bool recorded = finishRecorders();
+        out << "\n" << engine->name() << ": " << done << " generations in " << secs << " s ("
+            << (secs > 0 ? done / secs : 0) << " gen/s), population " << engine->population() << std::endl;
+        return recorded ? 0 : 1;
+    }
+
     Click click;
-    bool running = true;
+    bool paused       = false;
+    long pendingSteps = 0;  // "step N" while paused
+    bool capturedAny     = false;
+    uint64_t capturedGen = 0;  // last generation handed to the recorders
+    bool resync       = false;
 
     while (running) {
         SDL_Event e;
-        while (SDL_PollEvent(&e)) {
+        while (!headless && SDL_PollEvent(&e)) {
             click.handleEvent(e);
             
             if (e.type == SDL_QUIT) {
                 running = false;
             }
+            if (e.type == SDL_KEYDOWN || e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEWHEEL)
+                wake();
+            else if (e.type == SDL_WINDOWEVENT || e.type == SDL_RENDER_TARGETS_RESET)
+                redraw = true;  // exposed or resized: paint the still life again
+            if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                resizePending = true;  // only the last size counts
+                resizeWidth   = e.window.data1;
+                resizeHeight  = e.window.data2;
+            }
+
+            int row = click.gridRow(cellSize);
+            int col = click.gridCol(cellSize);
+            if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+                const auto& g = gol.getGrid();
+                bool alive    = row >= 0 && row < (int)g.size() && col >= 0 && col < (int)g[row].size() && g[row][col];
+                paintOp       = alive ? CellEdit::Clear : CellEdit::Set;
+                painter.add({row, col, paintOp});
+                painting = true;
+                lastRow  = row;
+                lastCol  = col;
+            } else if (e.type == SDL_MOUSEMOTION && painting && (row != lastRow || col != lastCol)) {
+                rasterizeLine(lastRow, lastCol, row, col, [&](int r, int c) {
+                    if (r != lastRow || c != lastCol)  // start cell was painted already
+                        painter.add({r, c, paintOp});
+                });
+                lastRow = row;
+                lastCol = col;
+            } else if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
+                painting = false;
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_LEFT) {
+                uint64_t gen = gol.getStats().generation;
+                if (gen > 0 && history.seek(gen - 1, restored)) {
+                    gol.restore(restored, gen - 1);
+                    paused = true;
+                }
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_j) {
+                fastForward(params["generations"].get<uint64_t>());
+                resync = true;  // not a missed frame
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_l) {
+                preview = !preview;
+                updateTitle();
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_h) {
+                heatmapMode = (heatmapMode + 1) % heatmapModes.size();
+                syncHeatmap();
+                updateTitle();
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_p) {
+                paletteIndex = (paletteIndex + 1) % paletteNames.size();
+                screen->setPalette(Palette::byName(paletteNames[paletteIndex]));
+                updateTitle();
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_m) {
+                minimap = !minimap;
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_g) {
+                gridLines = !gridLines;
+                screen->setGridLines(gridLines);
+            } else if (e.type == SDL_RENDER_TARGETS_RESET) {
+                screen->invalidateLayers();
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_u) {
+                uint64_t gen;
+                if (history.undo(restored, gen)) {
+                    gol.restore(restored, gen);
+                    paused = true;
+                }
+            }
         }
+        painter.flush();
 
-        if (click.leftClicked()) {
-            std::cout << "Clicked at: "
-                      << click.x() << ", " << click.y() << "\n";
+        if (resizePending) {
+            resizePending = false;
+            screen->resize(resizeWidth, resizeHeight);
+            // A window smaller than one cell still keeps a 1x1 board.
+            int rows = std::max(1, screen->visibleRows()), cols = std::max(1, screen->visibleCols());
+            if (worldResize == "grow") {
+                rows = std::max(rows, gol.getRows());
+                cols = std::max(cols, gol.getCols());
+            }
+            if (worldResize != "off" && !liveView && recorders.empty() &&
+                (rows != gol.getRows() || cols != gol.getCols())) {
+                wake();  // the replayed boards have the old size
+                gol.resize(rows, cols);
+                history = History(rows, cols, params["historyMB"].get<size_t>() << 20);
+                history.record(gol.getGrid(), gol.getStats().generation);
+            }
+            layoutViews();
         }
+        double workMs = scheduler.mark(FrameScheduler::Input);
 
-        SDL_Rect button{ 100, 100, 200, 100 };
-        if (click.leftClicked() && click.inside(button)) {
-            std::cout << "Button pressed!\n";
+        ControlCommand cmd;
+        while (control && control->poll(cmd)) {
+            wake();
+            switch (cmd.type) {
+                case ControlCommand::Pause:
+                    paused = true;
+                    break;
+                case ControlCommand::Resume:
+                    paused       = false;
+                    pendingSteps = 0;
+                    break;
+                case ControlCommand::Step:
+                    paused = true;
+                    pendingSteps += cmd.count;
+                    break;
+                case ControlCommand::SetRule:
+                    gol.setRule(cmd.rule);
+                    break;
+                case ControlCommand::Stamp:
+                    if (!stampPattern(gol, patterns, cmd.text, cmd.row, cmd.col))
+                        std::cerr << "control: unknown pattern " << cmd.text << std::endl;
+                    else
+                        history.record(gol.getGrid(), gol.getStats().generation, true);
+                    break;
+                case ControlCommand::Snapshot:
+                    try {
+                        savePattern(gol.getGrid(), "snapshot", cmd.text);
+                    } catch (const std::exception& ex) {
+                        std::cerr << "control: " << ex.what() << std::endl;
+                    }
+                    break;
+                case ControlCommand::Quit:
+                    running = false;
+                    break;
+            }
+        }
+
+        // Between generations: everything painted so far lands at once.
+        if (edits.applyTo(gol) > 0) {
+            history.record(gol.getGrid(), gol.getStats().generation, true);
+            idle.reset();
+        }
+        workMs += scheduler.mark(FrameScheduler::Update);
+
+        // While idle, the board on screen is the replayed one.
+        const GridView board = idle.period() ? GridView(idle.boardAt(idleGen)) : gol.view();
+        const uint64_t gen   = idle.period() ? idleGen : gol.getStats().generation;
+        const bool still     = idle.period() == 1 && !redraw;
+        auto decision = !screen || still ? RenderPolicy::Decision::Skip
+                        : frameSkip      ? renderPolicy.decide()
+                                         : RenderPolicy::Decision::Present;
+        int factor    = 1;  // only the plain grid view has a reduced image
+        const bool draw = screen && decision != RenderPolicy::Decision::Skip;
+        redraw          = false;
+        if (draw && preview)
+            screen->render(gol.simulateRegion(0, 0, std::min(gol.getRows(), screen->visibleRows()),
+                                              std::min(gol.getCols(), screen->visibleCols()), lookahead));
+        else if (draw && heatmapMode == 1)
+            screen->renderHeatmap(gol.ageView(), agePalette);
+        else if (draw && heatmapMode == 2)
+            screen->renderHeatmap(gol.activityView(), heatPalette);
+        else if (draw && decision == RenderPolicy::Decision::Reduced)
+            screen->renderReduced(board, factor = renderPolicy.factor());
+        else if (draw && minimap)
+            screen->renderViews(board, views);
+        else if (draw)
+            screen->render(board);
+        double renderMs = scheduler.mark(FrameScheduler::Render);
+        if (draw)
+            renderPolicy.rendered(factor, renderMs);
+        if (liveView && !still)
+            liveView->publish(board, gen);
+        // Record each generation once, not again on every pass while
+        // paused or waiting for "step N".
+        if (!recorders.empty() && (!capturedAny || gol.getStats().generation > capturedGen)) {
+            for (auto& rec : recorders) {
+                if (exportSource == "age")
+                    rec->captureStates(gol.ageView(), gol.getStats().generation);
+                else if (exportSource == "activity")
+                    rec->captureStates(gol.activityView(), gol.getStats().generation);
+                else
+                    rec->capture(gol.view(), gol.getStats().generation);
+                if (exportFrames && rec->stats().captured >= exportFrames)
+                    running = false;
+            }
+            capturedAny = true;
+            capturedGen = gol.getStats().generation;
         }
 
-        screen.render(gol.getGrid());
-        gol.step();
-        screen.pause(500);
+        if (idle.period() && !paused) {
+            if (idle.period() > 1)
+                ++idleGen;  // replay instead of stepping
+        } else if (!paused || pendingSteps > 0) {
+            // Stepping while paused runs flat out, one generation per
+            // pass, so "step 1000" finishes without a 1000-frame delay.
+            gol.step();
+            history.record(gol.getGrid(), gol.getStats().generation);
+            if (paused)
+                --pendingSteps;
+            if (!idleEnabled || paused || heatmapMode != 0) {
+                idle.reset();  // observations must be consecutive
+            } else if (idle.observe(gol.getGrid(), gol.getStats().generation)) {
+                idleGen = gol.getStats().generation;
+                if (screen)
+                    updateTitle();
+            }
+        }
+        if (control)
+            control->publishStats(gol.getStats(), paused, gol.getRule());
+        workMs += scheduler.mark(FrameScheduler::Update);
+        renderPolicy.stepped(workMs);
+
+        auto now = FrameScheduler::Clock::now();
+        if (screen && frameSkip && now - hudTime >= std::chrono::seconds(1)) {
+            double secs    = std::chrono::duration<double>(now - hudTime).count();
+            uint64_t seen  = renderPolicy.framesSeen() - hudSeen;
+            uint64_t skips = renderPolicy.framesSkipped() - hudSkipped;
+            char text[96];
+            std::snprintf(text, sizeof text, "%.1f fps shown, %.1f skipped, %.1f gen/s", (seen - skips) / secs,
+                          skips / secs, (gol.getStats().generation - hudGen) / secs);
+            hud        = text;
+            hudTime    = now;
+            hudGen     = gol.getStats().generation;
+            hudSeen    = renderPolicy.framesSeen();
+            hudSkipped = renderPolicy.framesSkipped();
+            updateTitle();
+        }
+
+        if (idle.period() == 1 && !paused) {
+            // Still life: nothing to do until someone interacts.
+            if (screen)
+                SDL_WaitEventTimeout(nullptr, idleWaitMs);  // leaves the event queued
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(idleWaitMs));
+            scheduler.resync();
+        } else if (resync || (paused && pendingSteps > 0)) {
+            scheduler.resync();
+        } else {
+            scheduler.wait();
+        }
+        resync = false;
     }
 
-    return 0;
+    bool recorded = finishRecorders();
+    out << "Frames: " << scheduler.summary() << std::endl;
+    if (screen && frameSkip)
+        out << "Render: " << renderPolicy.framesSkipped() << " skipped, " << renderPolicy.framesReduced()
+            << " reduced of " << renderPolicy.framesSeen() << std::endl;
+    return recorded ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "../includes/BitBoard.hpp"
+
+BitBoard::BitBoard(int rows, int cols)
+    : rows(rows),
+      cols(cols),
+      words((cols + 63) / 64),
+      tailMask(cols % 64 == 0 ? ~0ull : (1ull << (cols % 64)) - 1),
+      cells((size_t)(rows + 2) * words, 0) {
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("BitBoard: negative board size");
+    }
+}
+
+void BitBoard::load(const GridView& grid) {
+    std::fill(cells.cur(), cells.cur() + cells.size(), 0);
+    for (int r = 0; r < rows; ++r) grid.rowBits(r, row(r));
+}
+
+void BitBoard::store(std::vector<std::vector<int>>& grid) const {
+    for (int r = 0; r < rows; ++r) {
+        const uint64_t* in = row(r);
+        for (int c = 0; c < cols; ++c) grid[r][c] = (in[c >> 6] >> (c & 63)) & 1;
+    }
+}
+
+// --------------------------------------------------------------
+// Bit-sliced adders: each uint64_t holds one bit of 64 separate
+// sums, so these add 64 columns in parallel.
+// --------------------------------------------------------------
+static inline void fullAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t& sum, uint64_t& carry) {
+    uint64_t ab = a ^ b;
+    sum         = ab ^ c;
+    carry       = (a & b) | (ab & c);
+}
+
+static inline void halfAdd(uint64_t a, uint64_t b, uint64_t& sum, uint64_t& carry) {
+    sum   = a ^ b;
+    carry = a & b;
+}
+
+// --------------------------------------------------------------
+// step()
+//
+// For each word we gather the 8 neighbor bitmaps (left/right
+// neighbors come from shifting, borrowing one bit from the adjacent
+// word), add them into a 4-bit count (ones, twos, fours, eights)
+// and then apply the rule. Conway (B3/S23) gets a short formula;
+// any other Life-like rule tests each count 0..8 against its masks.
+// --------------------------------------------------------------
+void BitBoard::step(const LifeRule& rule) {
+    const bool conway = rule.birth == (1 << 3) && rule.survive == ((1 << 2) | (1 << 3));
+
+    for (int r = 1; r <= rows; ++r) {
+        const uint64_t* up  = cells.cur() + (size_t)(r - 1) * words;
+        const uint64_t* mid = cells.cur() + (size_t)r * words;
+        const uint64_t* dn  = cells.cur() + (size_t)(r + 1) * words;
+        uint64_t* out       = cells.next() + (size_t)r * words;
+
+        for (int w = 0; w < words; ++w) {
+            // Bit c of "west" is the cell at column c-1, "east" is c+1.
+            auto west = [&](const uint64_t* p) { return (p[w] << 1) | (w > 0 ? p[w - 1] >> 63 : 0); };
+            auto east = [&](const uint64_t* p) { return (p[w] >> 1) | (w + 1 < words ? p[w + 1] << 63 : 0); };
+
+            uint64_t s1, c1, s2, c2, s3, c3;
+            fullAdd(west(up), up[w], east(up), s1, c1);
+            fullAdd(west(dn), dn[w], east(dn), s2, c2);
+            halfAdd(west(mid), east(mid), s3, c3);
+
+            uint64_t ones, c4;
+            fullAdd(s1, s2, s3, ones, c4);  // c4 has weight 2
+
+            uint64_t t, fourA, twos, fourB;
+            fullAdd(c1, c2, c3, t, fourA);  // weight 2 inputs
+            halfAdd(t, c4, twos, fourB);
+
+            uint64_t fours  = fourA ^ fourB;
+            uint64_t eights = fourA & fourB;
+            uint64_t alive  = mid[w];
+
+            uint64_t result;
+            if (conway) {
+                // count == 3, or count == 2 and alive
+                result = twos & ~fours & ~eights & (ones | alive);
+            } else {
+                result = 0;
+                for (int n = 0; n <= 8; ++n) {
+                    uint64_t eq = (n & 1 ? ones : ~ones) & (n & 2 ? twos : ~twos) & (n & 4 ? fours : ~fours) &
+                                  (n & 8 ? eights : ~eights);
+                    if (rule.birth >> n & 1)
+                        result |= eq & ~alive;
+                    if (rule.survive >> n & 1)
+                        result |= eq & alive;
+                }
+            }
+            out[w] = result;
+        }
+        if (words > 0)
+            out[words - 1] &= tailMask;  // columns past the edge stay dead
+    }
+
+    cells.swap();
+}
+
+long BitBoard::population() const {
+    long count = 0;
+    for (int r = 0; r < rows; ++r)
+        for (int w = 0; w < words; ++w) count += __builtin_popcountll(row(r)[w]);
+    return count;
+}
+
+uint64_t BitBoard::hash() const {
+    uint64_t h = 0x9e3779b97f4a7c15ull;
+    for (int r = 0; r < rows; ++r) {
+        for (int w = 0; w < words; ++w) {
+            h ^= row(r)[w] + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            h *= 0xff51afd7ed558ccdull;
+        }
+    }
+    return h;
+}
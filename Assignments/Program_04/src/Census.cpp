@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "../includes/Census.hpp"
+
+long Cluster::population() const {
+    long n = 0;
+    for (uint8_t v : cells) n += v;
+    return n;
+}
+
+// --------------------------------------------------------------
+// Cluster finding: flood fill where every live cell within 2 rows
+// and 2 columns counts as connected. 'alive(r, c)' must return 0
+// outside rows x cols.
+// --------------------------------------------------------------
+template <typename Alive>
+static std::vector<Cluster> clustersOf(int rows, int cols, int row0, int col0, Alive alive) {
+    std::vector<Cluster> out;
+    std::vector<uint8_t> seen((size_t)rows * cols, 0);
+    std::vector<std::pair<int, int>> stack, members;
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (!alive(r, c) || seen[(size_t)r * cols + c])
+                continue;
+
+            members.clear();
+            stack.assign(1, {r, c});
+            seen[(size_t)r * cols + c] = 1;
+            int top = r, bottom = r, left = c, right = c;
+
+            while (!stack.empty()) {
+                auto [cr, cc] = stack.back();
+                stack.pop_back();
+                members.push_back({cr, cc});
+                top    = std::min(top, cr);
+                bottom = std::max(bottom, cr);
+                left   = std::min(left, cc);
+                right  = std::max(right, cc);
+
+                for (int dr = -2; dr <= 2; ++dr) {
+                    for (int dc = -2; dc <= 2; ++dc) {
+                        int nr = cr + dr, nc = cc + dc;
+                        if (nr < 0 || nr >= rows || nc < 0 || nc >= cols)
+                            continue;
+                        if (alive(nr, nc) && !seen[(size_t)nr * cols + nc]) {
+                            seen[(size_t)nr * cols + nc] = 1;
+                            stack.push_back({nr, nc});
+                        }
+                    }
+                }
+            }
+
+            Cluster cl;
+            cl.row0 = row0 + top;
+            cl.col0 = col0 + left;
+            cl.rows = bottom - top + 1;
+            cl.cols = right - left + 1;
+            cl.cells.assign((size_t)cl.rows * cl.cols, 0);
+            for (auto [mr, mc] : members) cl.cells[(size_t)(mr - top) * cl.cols + (mc - left)] = 1;
+            out.push_back(std::move(cl));
+        }
+    }
+    return out;
+}
+
+std::vector<Cluster> findClusters(const GridView& grid) {
+    return clustersOf(grid.rows(), grid.cols(), 0, 0, [&](int r, int c) { return grid.at(r, c) != 0; });
+}
+
+static std::vector<Cluster> splitCluster(const Cluster& cl) {
+    return clustersOf(cl.rows, cl.cols, cl.row0, cl.col0, [&](int r, int c) { return cl.at(r, c) != 0; });
+}
+
+// --------------------------------------------------------------
+// One generation of an isolated cluster. The result can grow by one
+// cell on each side and is cropped back to its live cells.
+// --------------------------------------------------------------
+static Cluster stepCluster(const Cluster& cl, const LifeRule& rule) {
+    auto alive = [&](int r, int c) { return r >= 0 && r < cl.rows && c >= 0 && c < cl.cols ? cl.at(r, c) : 0; };
+
+    int R = cl.rows + 2, C = cl.cols + 2;
+    std::vector<uint8_t> next((size_t)R * C, 0);
+    int top = R, bottom = -1, left = C, right = -1;
+
+    for (int r = 0; r < R; ++r) {
+        for (int c = 0; c < C; ++c) {
+            int sr = r - 1, sc = c - 1;  // cell position in 'cl'
+            int n  = 0;
+            for (int dr = -1; dr <= 1; ++dr)
+                for (int dc = -1; dc <= 1; ++dc)
+                    if (dr || dc)
+                        n += alive(sr + dr, sc + dc);
+
+            if (rule.next(alive(sr, sc), n)) {
+                next[(size_t)r * C + c] = 1;
+                top    = std::min(top, r);
+                bottom = std::max(bottom, r);
+                left   = std::min(left, c);
+                right  = std::max(right, c);
+            }
+        }
+    }
+
+    Cluster out;
+    if (bottom < 0) {
+        out.row0 = cl.row0;  // died out
+        out.col0 = cl.col0;
+        return out;
+    }
+    out.row0 = cl.row0 - 1 + top;
+    out.col0 = cl.col0 - 1 + left;
+    out.rows = bottom - top + 1;
+    out.cols = right - left + 1;
+    out.cells.resize((size_t)out.rows * out.cols);
+    for (int r = 0; r < out.rows; ++r)
+        for (int c = 0; c < out.cols; ++c) out.cells[(size_t)r * out.cols + c] = next[(size_t)(r + top) * C + c + left];
+    return out;
+}
+
+// "<rows>x<cols>_<hex>" of one orientation. Bit 0 of 'orientation'
+// flips rows, bit 1 flips columns, bit 2 transposes.
+static std::string orientedName(const Cluster& cl, int orientation) {
+    bool transpose = orientation & 4;
+    int rows = transpose ? cl.cols : cl.rows;
+    int cols = transpose ? cl.rows : cl.cols;
+
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    int nibble = 0, bits = 0;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int a = (orientation & 1) ? rows - 1 - r : r;
+            int b = (orientation & 2) ? cols - 1 - c : c;
+            nibble = nibble << 1 | (transpose ? cl.at(b, a) : cl.at(a, b));
+            if (++bits == 4) {
+                hex += digits[nibble];
+                nibble = bits = 0;
+            }
+        }
+    }
+    if (bits)
+        hex += digits[nibble << (4 - bits)];
+    return std::to_string(rows) + "x" + std::to_string(cols) + "_" + hex;
+}
+
+static std::string canonicalName(const Cluster& cl) {
+    std::string best = orientedName(cl, 0);
+    for (int o = 1; o < 8; ++o) best = std::min(best, orientedName(cl, o));
+    return best;
+}
+
+std::string canonicalKey(const Cluster& cluster, const LifeRule& rule) {
+    return rule.toString() + ":" + canonicalName(cluster);
+}
+
+// Exact (position-free) state key used for cycle detection.
+static std::string stateKey(const Cluster& cl) {
+    std::string key = std::to_string(cl.rows) + "x" + std::to_string(cl.cols) + ":";
+    key.append(cl.cells.begin(), cl.cells.end());
+    return key;
+}
+
+static ClusterFate fateOf(const Cluster& cluster, const LifeRule& rule, FateCache* cache, const CensusLimits& limits,
+                          int depth);
+
+// Fate of a state at generation 'gen' that has come apart into
+// independent parts: settled when every part is.
+static ClusterFate combine(const std::vector<Cluster>& parts, int gen, const LifeRule& rule, FateCache* cache,
+                           const CensusLimits& limits, int depth) {
+    ClusterFate fate;
+    fate.settled = true;
+    fate.period  = 1;
+    for (const Cluster& part : parts) {
+        ClusterFate pf = fateOf(part, rule, cache, limits, depth + 1);
+        if (!pf.settled)
+            return ClusterFate();
+        fate.settleGen = std::max(fate.settleGen, gen + pf.settleGen);
+        fate.period    = std::lcm(fate.period, pf.period);
+        fate.population += pf.population;
+        fate.objects.insert(fate.objects.end(), pf.objects.begin(), pf.objects.end());
+    }
+    std::sort(fate.objects.begin(), fate.objects.end());
+    return fate;
+}
+
+// --------------------------------------------------------------
+// evolve(): step the cluster until a state repeats (up to a shift).
+// The cycle found gives the period; a shift means a spaceship.
+//
+// A settled state that falls apart into several clusters is named
+// object by object (each one's fate comes from the cache if
+// possible). Oscillators are named by the phase whose canonical
+// name sorts first, so every phase gets the same name.
+// --------------------------------------------------------------
+static ClusterFate evolve(const Cluster& start, const LifeRule& rule, FateCache* cache, const CensusLimits& limits,
+                          int depth) {
+    ClusterFate fate;
+    std::unordered_map<std::string, int> seen;  // state key → generation
+    std::vector<Cluster> states;
+
+    Cluster cur = start;
+    for (int gen = 0; gen <= limits.maxGenerations; ++gen) {
+        auto [it, fresh] = seen.emplace(stateKey(cur), gen);
+        if (!fresh) {
+            const Cluster& first = states[it->second];
+            fate.settled         = true;
+            fate.settleGen       = it->second;
+            fate.period          = gen - it->second;
+            fate.population      = cur.population();
+            if (fate.population == 0)
+                return fate;  // died out: no objects
+
+            std::string name = canonicalName(cur);
+            for (int g = fate.settleGen + 1; g < gen; ++g) name = std::min(name, canonicalName(states[g]));
+
+            if (cur.row0 != first.row0 || cur.col0 != first.col0) {
+                fate.objects.push_back("xq" + std::to_string(fate.period) + "_" + name);
+                return fate;
+            }
+
+            std::vector<Cluster> parts = splitCluster(cur);
+            if (parts.size() > 1 && depth < 4) {
+                std::vector<std::string> objects;
+                bool allSettled = true;
+                for (const Cluster& part : parts) {
+                    ClusterFate pf = fateOf(part, rule, cache, limits, depth + 1);
+                    allSettled     = allSettled && pf.settled && pf.settleGen == 0;
+                    objects.insert(objects.end(), pf.objects.begin(), pf.objects.end());
+                }
+                // Parts that only settle together are one object.
+                if (allSettled) {
+                    fate.objects = std::move(objects);
+                    std::sort(fate.objects.begin(), fate.objects.end());
+                    return fate;
+                }
+            }
+
+            fate.objects.push_back(fate.period == 1 ? "xs" + std::to_string(fate.population) + "_" + name
+                                                    : "xp" + std::to_string(fate.period) + "_" + name);
+            return fate;
+        }
+
+        states.push_back(cur);
+        cur = stepCluster(cur, rule);
+        if (cur.rows > limits.maxExtent || cur.cols > limits.maxExtent)
+            break;
+
+        // ------------------------------------------------------
+        // Escapes: once the box has grown well past the start, the
+        // cluster has usually thrown off gliders. If it has come
+        // apart, follow each part on its own instead.
+        // ------------------------------------------------------
+        if (depth < 4 && gen % 16 == 15 &&
+            (cur.rows > 2 * start.rows + 16 || cur.cols > 2 * start.cols + 16)) {
+            std::vector<Cluster> parts = splitCluster(cur);
+            if (parts.size() > 1)
+                return combine(parts, gen + 1, rule, cache, limits, depth);
+        }
+    }
+    return fate;  // unsettled
+}
+
+static ClusterFate fateOf(const Cluster& cluster, const LifeRule& rule, FateCache* cache, const CensusLimits& limits,
+                          int depth) {
+    if (!cache)
+        return evolve(cluster, rule, nullptr, limits, depth);
+
+    // A nested cluster may be split less (see evolve()), so its fate
+    // is only shared with clusters at the same depth and limits.
+    std::string key = canonicalKey(cluster, rule) + "@" + std::to_string(depth) + "/" +
+                      std::to_string(limits.maxGenerations) + "/" + std::to_string(limits.maxExtent);
+    ClusterFate fate;
+    if (cache->lookup(key, fate))
+        return fate;
+    fate = evolve(cluster, rule, cache, limits, depth);
+    cache->insert(key, fate);
+    return fate;
+}
+
+ClusterFate clusterFate(const Cluster& cluster, const LifeRule& rule, FateCache* cache, const CensusLimits& limits) {
+    if (rule.birth & 1) {
+        throw std::invalid_argument("census: B0 rules turn the whole plane on; clusters are not isolated");
+    }
+    return fateOf(cluster, rule, cache, limits, 0);
+}
+
+CensusResult census(const GridView& grid, const LifeRule& rule, FateCache* cache,
+                    const CensusLimits& limits) {
+    CensusResult result;
+    for (const Cluster& cl : findClusters(grid)) {
+        ClusterFate fate = clusterFate(cl, rule, cache, limits);
+        result.clusters++;
+        if (!fate.settled) {
+            result.unsettled++;
+            continue;
+        }
+        for (const auto& name : fate.objects) result.objects[name]++;
+    }
+    return result;
+}
@@ -0,0 +1,186 @@
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "../includes/ControlServer.hpp"
+
+// --------------------------------------------------------------
+// removeStaleSocket(): a socket left behind by a run that died is
+// removed; anything else at 'addr' (a regular file, or the socket of
+// an instance that still accepts connections) is left alone and
+// bind() then fails.
+// --------------------------------------------------------------
+static void removeStaleSocket(const sockaddr_un& addr) {
+    struct stat st;
+    if (lstat(addr.sun_path, &st) != 0 || !S_ISSOCK(st.st_mode))
+        return;
+
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0)
+        return;
+    bool stale = connect(probe, (const sockaddr*)&addr, sizeof(addr)) != 0 && errno == ECONNREFUSED;
+    close(probe);
+    if (stale)
+        unlink(addr.sun_path);
+}
+
+ControlServer::ControlServer(const std::string& socketPath, size_t queueCapacity)
+    : path(socketPath), queue(queueCapacity) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("ControlServer: socket path too long");
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("ControlServer: socket() failed");
+    }
+    removeStaleSocket(addr);
+    if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 8) != 0) {
+        close(listenFd);
+        throw std::runtime_error("ControlServer: cannot listen on " + path);
+    }
+
+    worker = std::thread(&ControlServer::serve, this);
+}
+
+ControlServer::~ControlServer() {
+    stopping.store(true);
+    if (worker.joinable())
+        worker.join();
+    close(listenFd);
+    unlink(path.c_str());
+}
+
+void ControlServer::publishStats(const AutomatonStats& stats, bool paused, const LifeRule& rule) {
+    std::lock_guard<std::mutex> guard(statsLock);
+    latest.stats  = stats;
+    latest.paused = paused;
+    latest.rule   = rule;
+}
+
+// --------------------------------------------------------------
+// serve(): socket thread. poll() with a short timeout so the
+// destructor can stop us without needing to wake the thread.
+// --------------------------------------------------------------
+void ControlServer::serve() {
+    std::map<int, std::string> pending;  // fd → partial input line
+
+    while (!stopping.load()) {
+        std::vector<pollfd> fds{{listenFd, POLLIN, 0}};
+        for (auto& [fd, buf] : pending) fds.push_back({fd, POLLIN, 0});
+
+        if (::poll(fds.data(), fds.size(), 200) <= 0)
+            continue;
+
+        if (fds[0].revents & POLLIN) {
+            int client = accept(listenFd, nullptr, nullptr);
+            if (client >= 0)
+                pending[client] = "";
+        }
+
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            int fd = fds[i].fd;
+            char chunk[512];
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            if (n <= 0) {
+                close(fd);
+                pending.erase(fd);
+                continue;
+            }
+
+            std::string& buf = pending[fd];
+            buf.append(chunk, n);
+            size_t eol;
+            while ((eol = buf.find('\n')) != std::string::npos) {
+                std::string reply = handleLine(buf.substr(0, eol));
+                buf.erase(0, eol + 1);
+                send(fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+            }
+            if (buf.size() > 4096) {  // no sane command is this long
+                close(fd);
+                pending.erase(fd);
+            }
+        }
+    }
+
+    for (auto& [fd, buf] : pending) close(fd);
+}
+
+// --------------------------------------------------------------
+// handleLine(): parse one command and either answer it (stats,
+// help) or queue it for the engine. Returns the reply text.
+// --------------------------------------------------------------
+std::string ControlServer::handleLine(const std::string& line) {
+    std::istringstream in(line);
+    std::string verb;
+    in >> verb;
+
+    ControlCommand cmd;
+    if (verb.empty()) {
+        return "";
+    } else if (verb == "help") {
+        return "commands: pause, resume, step N, rule B3/S23, stamp <pattern> <row> <col>, "
+               "snapshot <path>, stats, quit\n";
+    } else if (verb == "stats") {
+        StatsSnapshot snap;
+        {
+            std::lock_guard<std::mutex> guard(statsLock);
+            snap = latest;
+        }
+        std::ostringstream out;
+        out << "generation=" << snap.stats.generation << " population=" << snap.stats.population
+            << " births=" << snap.stats.births << " deaths=" << snap.stats.deaths << " paused=" << snap.paused
+            << " rule=" << snap.rule.toString() << "\n";
+        return out.str();
+    } else if (verb == "pause") {
+        cmd.type = ControlCommand::Pause;
+    } else if (verb == "resume") {
+        cmd.type = ControlCommand::Resume;
+    } else if (verb == "quit") {
+        cmd.type = ControlCommand::Quit;
+    } else if (verb == "step") {
+        cmd.type  = ControlCommand::Step;
+        cmd.count = 1;
+        in >> cmd.count;
+        if (cmd.count <= 0)
+            return "error: step count must be positive\n";
+    } else if (verb == "rule") {
+        std::string text;
+        in >> text;
+        try {
+            cmd.rule = LifeRule::parse(text);
+        } catch (const std::invalid_argument& e) {
+            return std::string("error: ") + e.what() + "\n";
+        }
+        cmd.type = ControlCommand::SetRule;
+    } else if (verb == "stamp") {
+        cmd.type = ControlCommand::Stamp;
+        if (!(in >> cmd.text >> cmd.row >> cmd.col))
+            return "error: usage: stamp <pattern> <row> <col>\n";
+    } else if (verb == "snapshot") {
+        cmd.type = ControlCommand::Snapshot;
+        if (!(in >> cmd.text))
+            return "error: usage: snapshot <path>\n";
+    } else {
+        return "error: unknown command '" + verb + "' (try help)\n";
+    }
+
+    // Never wait for the engine: if it is that far behind, say so.
+    if (!queue.tryPush(std::move(cmd)))
+        return "error: busy, command queue full\n";
+    return "ok\n";
+}
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "../includes/DensityPyramid.hpp"
+
+void DensityPyramid::build(const GridView& grid) {
+    rows = grid.rows();
+    cols = grid.cols();
+    levels.resize(MAX_LEVEL + 1);
+
+    // Level 1: each pair of grid rows adds into one row of counts.
+    const int lr = levelRows(1), lc = levelCols(1);
+    std::vector<uint32_t>& out = levels[1];
+    out.assign((size_t)lr * lc, 0);
+    line.resize(cols);
+    for (int r = 0; r < rows; ++r) {
+        uint32_t* sums = &out[(size_t)(r >> 1) * lc];
+        grid.rowAlive(r, 0, cols, line.data());
+        for (int c = 0; c < cols; ++c) sums[c >> 1] += line[c];
+    }
+    built = 1;
+    ++buildCount;
+}
+
+const std::vector<uint32_t>& DensityPyramid::level(int level) {
+    if (level < 1 || level > MAX_LEVEL || built == 0) {
+        throw std::out_of_range("DensityPyramid: no level " + std::to_string(level));
+    }
+    for (; built < level; ++built) {
+        const std::vector<uint32_t>& below = levels[built];
+        const int br = levelRows(built), bc = levelCols(built);
+        const int lr = levelRows(built + 1), lc = levelCols(built + 1);
+        std::vector<uint32_t>& out = levels[built + 1];
+        out.assign((size_t)lr * lc, 0);
+        for (int r = 0; r < br; ++r) {
+            uint32_t* line     = &out[(size_t)(r >> 1) * lc];
+            const uint32_t* in = &below[(size_t)r * bc];
+            for (int c = 0; c < bc; ++c) line[c >> 1] += in[c];
+        }
+    }
+    return levels[level];
+}
+
+int DensityPyramid::levelFor(double cellsPerPixel) {
+    int level = 1;
+    while (level < MAX_LEVEL && (1 << level) < cellsPerPixel) ++level;
+    return level;
+}
+
+void DensityPyramid::shade(int lvl, int row0, int col0, int nrows, int ncols, std::vector<uint8_t>& out, int floor) {
+    const std::vector<uint32_t>& counts = level(lvl);
+    const int lr = levelRows(lvl), lc = levelCols(lvl);
+    const int shift = 2 * lvl;  // a full block holds 1 << shift cells
+    auto shadeOf    = [&](uint32_t n) { return n ? (uint8_t)(floor + ((uint64_t)(255 - floor) * n >> shift)) : 0; };
+
+    out.assign((size_t)nrows * ncols, 0);
+    for (int r = std::max(0, -row0); r < nrows && row0 + r < lr; ++r) {
+        const uint32_t* in = &counts[(size_t)(row0 + r) * lc];
+        uint8_t* line      = &out[(size_t)r * ncols];
+        for (int c = std::max(0, -col0); c < ncols && col0 + c < lc; ++c) line[c] = shadeOf(in[col0 + c]);
+    }
+}
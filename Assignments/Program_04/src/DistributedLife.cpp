@@ -0,0 +1,296 @@
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../includes/DistributedLife.hpp"
+
+// --------------------------------------------------------------
+// Neighbor directions, clockwise from north.
+//   0=N 1=NE 2=E 3=SE 4=S 5=SW 6=W 7=NW
+// The opposite of direction d is (d + 4) % 8.
+// --------------------------------------------------------------
+static const int DIR_DR[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+static const int DIR_DC[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+static int opposite(int dir) {
+    return (dir + 4) % 8;
+}
+
+DistributedLife::DistributedLife(int r, int c, int workers)
+    : ConwayLife(r, c), workers(workers), procRows(1), procCols(workers) {
+    if (workers < 1 || workers > r * c) {
+        throw std::invalid_argument("DistributedLife: worker count must be in [1, rows*cols]");
+    }
+
+    // ----------------------------------------------------------
+    // Pick the process grid (procRows x procCols == workers) whose
+    // subdomains have the smallest perimeter, i.e. the least halo
+    // traffic per generation.
+    // ----------------------------------------------------------
+    double best = -1;
+    for (int pr = 1; pr <= workers; ++pr) {
+        if (workers % pr != 0)
+            continue;
+        int pc = workers / pr;
+        if (pr > r || pc > c)
+            continue;
+        double perimeter = (double)r / pr + (double)c / pc;
+        if (best < 0 || perimeter < best) {
+            best     = perimeter;
+            procRows = pr;
+            procCols = pc;
+        }
+    }
+    if (best < 0) {
+        throw std::invalid_argument("DistributedLife: board too small for worker count");
+    }
+}
+
+void DistributedLife::step() {
+    run(1);
+}
+
+uint64_t DistributedLife::advance(uint64_t n, const std::function<bool(uint64_t)>& progress) {
+    const uint64_t CHUNK = 4096;  // generations per fork/join round
+    uint64_t done        = 0;
+    while (done < n) {
+        if (progress && done > 0 && !progress(done))
+            break;
+        int chunk = (int)std::min(CHUNK, n - done);
+        run(chunk);
+        done += chunk;
+    }
+    return done;
+}
+
+DistributedLife::Subdomain DistributedLife::subdomain(int worker) const {
+    int pr = worker / procCols;
+    int pc = worker % procCols;
+
+    Subdomain s;
+    s.row0 = pr * rows / procRows;
+    s.col0 = pc * cols / procCols;
+    s.rows = (pr + 1) * rows / procRows - s.row0;
+    s.cols = (pc + 1) * cols / procCols - s.col0;
+    return s;
+}
+
+int DistributedLife::neighbor(int worker, int dir) const {
+    int pr = worker / procCols + DIR_DR[dir];
+    int pc = worker % procCols + DIR_DC[dir];
+    if (pr < 0 || pr >= procRows || pc < 0 || pc >= procCols)
+        return -1;  // board edge: halo stays dead
+    return pr * procCols + pc;
+}
+
+std::unique_ptr<HaloTransport> DistributedLife::makeTransport(int channels, size_t slotBytes) {
+    return std::make_unique<ShmRingTransport>(channels, slotBytes);
+}
+
+// --------------------------------------------------------------
+// run(generations)
+//
+// The parent copies the board into a shared byte array, forks one
+// process per subdomain, and waits. Each worker reads its cells from
+// the shared array, evolves them, and writes them back in place.
+// Subdomains are disjoint, so no locking is needed for the gather.
+// --------------------------------------------------------------
+void DistributedLife::run(int generations) {
+    if (generations <= 0)
+        return;
+
+    size_t boardBytes = (size_t)rows * cols;
+    void* p           = mmap(nullptr, boardBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("DistributedLife: mmap failed");
+    }
+    uint8_t* shared = static_cast<uint8_t*>(p);
+
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) shared[(size_t)r * cols + c] = grid[r][c] ? 1 : 0;
+
+    // Largest edge piece any worker will ever send.
+    size_t slotBytes = 1;
+    for (int w = 0; w < workers; ++w) {
+        Subdomain s = subdomain(w);
+        slotBytes   = std::max(slotBytes, (size_t)std::max(s.rows, s.cols));
+    }
+    std::unique_ptr<HaloTransport> transport = makeTransport(workers * 8, slotBytes);
+
+    std::vector<pid_t> pids;
+    for (int w = 0; w < workers; ++w) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            for (pid_t child : pids) kill(child, SIGKILL);
+            for (pid_t child : pids) waitpid(child, nullptr, 0);
+            munmap(shared, boardBytes);
+            throw std::runtime_error("DistributedLife: fork failed");
+        }
+        if (pid == 0) {
+            // Child: never return into the caller's stack, and skip
+            // atexit handlers (SDL etc.) that belong to the parent.
+            try {
+                runWorker(w, *transport, shared, generations);
+            } catch (...) {
+                transport->abort();  // release neighbours waiting on us
+                _exit(1);
+            }
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+
+    // Reap workers as they exit (only our own pids: waitpid(-1)
+    // could steal an encoder child from the caller). On the first
+    // failure (an exception, or a crash that never reached abort()),
+    // abort the transport and kill the rest, which may be spinning
+    // on halos that will never come.
+    bool failed = false;
+    while (!pids.empty()) {
+        bool reaped = false;
+        for (size_t i = 0; i < pids.size(); ++i) {
+            int status = 0;
+            pid_t done = waitpid(pids[i], &status, WNOHANG);
+            if (done == 0)
+                continue;
+            bool ok = done > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            pids.erase(pids.begin() + i--);
+            reaped = true;
+            if (!ok && !failed) {
+                failed = true;
+                transport->abort();
+                for (pid_t other : pids) kill(other, SIGKILL);
+            }
+        }
+        if (!reaped)
+            usleep(200);
+    }
+
+    if (!failed) {
+        // births/deaths are relative to the start of this run, which
+        // is exactly "the last step" when generations == 1.
+        // A single step keeps the heatmap exact; longer runs reset it.
+        long born = 0, died = 0, alive = 0;
+        std::vector<int> row(cols);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                int v = shared[(size_t)r * cols + c];
+                born += !grid[r][c] && v;
+                died += grid[r][c] && !v;
+                alive += v;
+                row[c] = v;
+            }
+            if (heatmapOn && generations == 1)
+                updateHeatmapRow(r, grid[r], row);
+            grid[r].swap(row);
+        }
+        if (generations != 1)
+            resetHeatmap();
+        counters.generation += generations;
+        counters.population = alive;
+        counters.births     = born;
+        counters.deaths     = died;
+    }
+    munmap(shared, boardBytes);
+
+    if (failed) {
+        throw std::runtime_error("DistributedLife: a worker process failed");
+    }
+}
+
+// --------------------------------------------------------------
+// runWorker(): the per-process generation loop.
+//
+// Local buffers are (h+2) x (w+2) with a one-cell halo. Local cell
+// (i, j) with 1 <= i <= h, 1 <= j <= w is global cell
+// (row0 + i - 1, col0 + j - 1).
+// --------------------------------------------------------------
+void DistributedLife::runWorker(int worker, HaloTransport& transport, uint8_t* shared, int generations) const {
+    const Subdomain s = subdomain(worker);
+    const int h       = s.rows;
+    const int w       = s.cols;
+    const int stride  = w + 2;
+
+    std::vector<uint8_t> cur((size_t)(h + 2) * stride, 0);
+    std::vector<uint8_t> next((size_t)(h + 2) * stride, 0);
+    std::vector<uint8_t> msg((size_t)std::max(h, w));
+
+    for (int i = 1; i <= h; ++i)
+        for (int j = 1; j <= w; ++j) cur[(size_t)i * stride + j] = shared[(size_t)(s.row0 + i - 1) * cols + s.col0 + j - 1];
+
+    int peers[8];
+    for (int d = 0; d < 8; ++d) peers[d] = neighbor(worker, d);
+
+    auto update = [&](int i, int j) {
+        const uint8_t* up  = &cur[(size_t)(i - 1) * stride + j];
+        const uint8_t* mid = &cur[(size_t)i * stride + j];
+        const uint8_t* dn  = &cur[(size_t)(i + 1) * stride + j];
+        int n = up[-1] + up[0] + up[1] + mid[-1] + mid[1] + dn[-1] + dn[0] + dn[1];
+        next[(size_t)i * stride + j] = rule.next(mid[0], n);
+    };
+
+    for (int g = 0; g < generations; ++g) {
+        // 1. Post our edges. Rows are contiguous; columns are gathered.
+        for (int d = 0; d < 8; ++d) {
+            if (peers[d] < 0)
+                continue;
+            int i = DIR_DR[d] < 0 ? 1 : h;
+            int j = DIR_DC[d] < 0 ? 1 : w;
+            size_t n;
+            if (DIR_DC[d] == 0) {  // N / S: one full row
+                std::copy_n(&cur[(size_t)i * stride + 1], w, msg.begin());
+                n = w;
+            } else if (DIR_DR[d] == 0) {  // E / W: one full column
+                for (int r = 1; r <= h; ++r) msg[r - 1] = cur[(size_t)r * stride + j];
+                n = h;
+            } else {  // corner: a single cell
+                msg[0] = cur[(size_t)i * stride + j];
+                n      = 1;
+            }
+            transport.send(worker * 8 + d, msg.data(), n);
+        }
+
+        // 2. Interior cells only read our own cells.
+        for (int i = 2; i < h; ++i)
+            for (int j = 2; j < w; ++j) update(i, j);
+
+        // 3. Collect halos; missing neighbors leave dead cells.
+        for (int d = 0; d < 8; ++d) {
+            if (peers[d] < 0)
+                continue;
+            int i = DIR_DR[d] < 0 ? 0 : h + 1;
+            int j = DIR_DC[d] < 0 ? 0 : w + 1;
+            int channel = peers[d] * 8 + opposite(d);
+            if (DIR_DC[d] == 0) {
+                transport.recv(channel, &cur[(size_t)i * stride + 1], w);
+            } else if (DIR_DR[d] == 0) {
+                transport.recv(channel, msg.data(), h);
+                for (int r = 1; r <= h; ++r) cur[(size_t)r * stride + j] = msg[r - 1];
+            } else {
+                transport.recv(channel, &cur[(size_t)i * stride + j], 1);
+            }
+        }
+
+        // 4. Border cells (first/last row and column).
+        for (int j = 1; j <= w; ++j) {
+            update(1, j);
+            if (h > 1)
+                update(h, j);
+        }
+        for (int i = 2; i < h; ++i) {
+            update(i, 1);
+            if (w > 1)
+                update(i, w);
+        }
+
+        // Halo cells in 'next' are stale but always overwritten by
+        // step 3 before they are read again.
+        std::swap(cur, next);
+    }
+
+    for (int i = 1; i <= h; ++i)
+        for (int j = 1; j <= w; ++j) shared[(size_t)(s.row0 + i - 1) * cols + s.col0 + j - 1] = cur[(size_t)i * stride + j];
+}
@@ -0,0 +1,81 @@
+#include <functional>
+
+#include "../includes/FateCache.hpp"
+
+FateCache::FateCache(size_t maxBytes, int shardCount) {
+    if (shardCount < 1)
+        shardCount = 1;
+    for (int i = 0; i < shardCount; ++i) shards.push_back(std::make_unique<Shard>());
+    shardBudget = maxBytes / shardCount;
+}
+
+FateCache::Shard& FateCache::shardFor(const std::string& key) {
+    return *shards[std::hash<std::string>()(key) % shards.size()];
+}
+
+// Payload plus a rough allowance for the list node, the hash-table
+// node and the string/vector headers.
+size_t FateCache::entryBytes(const std::string& key, const ClusterFate& fate) {
+    size_t n = 2 * key.size() + sizeof(ClusterFate) + 96;
+    for (const auto& name : fate.objects) n += name.size() + sizeof(std::string);
+    return n;
+}
+
+bool FateCache::lookup(const std::string& key, ClusterFate& out) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);  // now most recent
+    out = it->second->second;
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FateCache::insert(const std::string& key, const ClusterFate& fate) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    if (shard.index.count(key))
+        return;  // another thread got there first; the fate is the same
+
+    shard.lru.emplace_front(key, fate);
+    shard.index[key] = shard.lru.begin();
+    shard.bytes += entryBytes(key, fate);
+
+    // Keep at least the new entry, even if it alone is over budget.
+    while (shard.bytes > shardBudget && shard.lru.size() > 1) {
+        auto& oldest = shard.lru.back();
+        shard.bytes -= entryBytes(oldest.first, oldest.second);
+        shard.index.erase(oldest.first);
+        shard.lru.pop_back();
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FateCacheStats FateCache::stats() const {
+    FateCacheStats s;
+    s.hits      = hits.load(std::memory_order_relaxed);
+    s.misses    = misses.load(std::memory_order_relaxed);
+    s.evictions = evictions.load(std::memory_order_relaxed);
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        s.entries += shard->lru.size();
+        s.bytes += shard->bytes;
+    }
+    return s;
+}
+
+void FateCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        shard->lru.clear();
+        shard->index.clear();
+        shard->bytes = 0;
+    }
+    hits = misses = evictions = 0;
+}
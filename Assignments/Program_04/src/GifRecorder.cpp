@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "../includes/GifRecorder.hpp"
+
+// --------------------------------------------------------------
+// LzwEncoder: GIF-flavored LZW (variable code size up to 12 bits,
+// clear code when the table fills), packed LSB-first into 255-byte
+// sub-blocks appended to 'out'. The string table maps (prefix code,
+// next pixel) to a code: a direct array for alphabets of up to 16
+// colors, the classic open-addressed hash for larger ones.
+// --------------------------------------------------------------
+namespace {
+class LzwEncoder {
+   public:
+    LzwEncoder(int minCodeSize, std::vector<uint8_t>& out)
+        : minCodeSize(minCodeSize), clearCode(1 << minCodeSize), direct(minCodeSize <= 4), out(out) {
+        if (direct)
+            children.resize((size_t)4096 << minCodeSize);
+        out.push_back((uint8_t)minCodeSize);
+        reset();
+        emit(clearCode);
+    }
+
+    void put(uint8_t pixel) {
+        if (prefix < 0) {
+            prefix = pixel;
+            return;
+        }
+        if (direct) {
+            // Small alphabets (cell recordings): index the table
+            // directly instead of hashing.
+            int16_t& child = children[prefix << minCodeSize | pixel];
+            if (child >= 0) {
+                prefix = child;
+                return;
+            }
+            emit(prefix);
+            child = (int16_t)nextCode++;
+            added();
+            prefix = pixel;
+            return;
+        }
+        int key = prefix << 8 | pixel;
+        int h   = (pixel << 12 ^ prefix) % HSIZE;
+        while (keys[h] >= 0) {
+            if (keys[h] == key) {
+                prefix = codes[h];
+                return;
+            }
+            h = h + 1 == HSIZE ? 0 : h + 1;
+        }
+
+        emit(prefix);
+        keys[h]  = key;
+        codes[h] = (int16_t)nextCode++;
+        added();
+        prefix = pixel;
+    }
+
+    void finish() {
+        if (prefix >= 0)
+            emit(prefix);
+        emit(clearCode + 1);  // end of information
+        if (bitCount > 0)
+            pushByte((uint8_t)bits);
+        flushBlock();
+        out.push_back(0);  // block terminator
+    }
+
+   private:
+    static constexpr int HSIZE = 5003;  // prime, > 4096
+
+    void reset() {
+        if (direct)
+            std::fill(children.begin(), children.end(), -1);
+        else
+            std::fill(std::begin(keys), std::end(keys), -1);
+        nextCode = clearCode + 2;
+        codeSize = minCodeSize + 1;
+    }
+
+    // After a new code: widen codes, or start over when full.
+    void added() {
+        if (nextCode - 1 >= (1 << codeSize) && codeSize < 12)
+            ++codeSize;
+        if (nextCode == 4096) {
+            emit(clearCode);
+            reset();
+        }
+    }
+
+    void emit(int code) {
+        bits |= (uint32_t)code << bitCount;
+        bitCount += codeSize;
+        while (bitCount >= 8) {
+            pushByte((uint8_t)bits);
+            bits >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    void pushByte(uint8_t b) {
+        block[blockLen++] = b;
+        if (blockLen == 255)
+            flushBlock();
+    }
+
+    void flushBlock() {
+        if (blockLen == 0)
+            return;
+        out.push_back((uint8_t)blockLen);
+        out.insert(out.end(), block, block + blockLen);
+        blockLen = 0;
+    }
+
+    int minCodeSize, clearCode;
+    bool direct;
+    int nextCode = 0, codeSize = 0;
+    int prefix   = -1;
+    std::vector<int16_t> children;  // direct: [code << minCodeSize | pixel]
+    int keys[HSIZE];                // hashed: prefix << 8 | pixel
+    int16_t codes[HSIZE];
+
+    uint32_t bits = 0;
+    int bitCount  = 0;
+    uint8_t block[255];
+    int blockLen = 0;
+    std::vector<uint8_t>& out;
+};
+
+void put16(std::vector<uint8_t>& out, int v) {
+    out.push_back((uint8_t)(v & 0xFF));
+    out.push_back((uint8_t)(v >> 8 & 0xFF));
+}
+}  // namespace
+
+GifRecorder::Disposal GifRecorder::parseDisposal(const std::string& name) {
+    if (name == "keep")
+        return Disposal::Keep;
+    if (name == "background")
+        return Disposal::Background;
+    if (name == "previous")
+        return Disposal::Previous;
+    throw std::invalid_argument("unknown GIF disposal '" + name + "' (keep, background, previous)");
+}
+
+GifRecorder::GifRecorder(const std::string& target, int rows, int cols, int scale, const Palette& palette, int colors,
+                         int delayCs, Disposal disposal, int every, bool lossless)
+    : Recorder(rows, cols, every, lossless),
+      target(target),
+      scale(std::max(1, scale)),
+      colorBits(1),
+      delayCs(std::clamp(delayCs, 0, 65535)),
+      disposal(disposal),
+      canvas((size_t)rows * cols, 0) {
+    int width = cols * this->scale, height = rows * this->scale;
+    if (width > 65535 || height > 65535) {
+        throw std::invalid_argument("GIF frames are limited to 65535 x 65535 pixels");
+    }
+    while ((1 << colorBits) < colors && colorBits < 8) ++colorBits;
+
+    // Header, logical screen, global color table, loop forever.
+    std::vector<uint8_t> head = {'G', 'I', 'F', '8', '9', 'a'};
+    put16(head, width);
+    put16(head, height);
+    head.push_back((uint8_t)(0x80 | (colorBits - 1) << 4 | (colorBits - 1)));
+    head.push_back(0);  // background color index
+    head.push_back(0);  // no aspect ratio
+    for (int i = 0; i < (1 << colorBits); ++i) {
+        Rgb c = palette[(uint8_t)i];
+        head.insert(head.end(), {c.r, c.g, c.b});
+    }
+    const char netscape[] = "\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00";
+    head.insert(head.end(), netscape, netscape + sizeof netscape - 1);
+
+    out = openOutput(target);
+    write(out, head.data(), head.size());
+    start();
+}
+
+GifRecorder::~GifRecorder() {
+    try {
+        finish();
+    } catch (const std::exception& ex) {
+        std::cerr << "gif: " << ex.what() << std::endl;
+    }
+    if (out)
+        closeOutput(out, target);  // only after a failed encode
+}
+
+// Bounding box of the cells where 'frame' differs from the canvas.
+GifRecorder::Rect GifRecorder::changedRect(const Frame& frame) const {
+    int top = rows, bottom = -1, left = cols, right = -1;
+    const uint8_t* now  = frame.cells.data();
+    const uint8_t* seen = canvas.data();
+    for (int r = 0; r < rows; ++r, now += cols, seen += cols) {
+        if (std::memcmp(now, seen, cols) == 0)
+            continue;
+        top    = std::min(top, r);
+        bottom = r;
+        int c0 = 0, c1 = cols - 1;
+        while (now[c0] == seen[c0]) ++c0;
+        while (now[c1] == seen[c1]) --c1;
+        left  = std::min(left, c0);
+        right = std::max(right, c1);
+    }
+    if (bottom < 0)
+        return Rect();
+    return {top, left, bottom - top + 1, right - left + 1};
+}
+
+void GifRecorder::encode(const Frame& frame) {
+    if (!first && frame.cells == last) {
+        pendingDelay = std::min(pendingDelay + delayCs, 65535);  // nothing moved: hold the last frame
+        return;
+    }
+
+    // After Background/Previous disposal the canvas may already show
+    // this frame; a 1x1 image still has to carry its delay.
+    Rect rect = first ? Rect{0, 0, rows, cols} : changedRect(frame);
+    if (rect.rows == 0)
+        rect = {0, 0, 1, 1};
+    first = false;
+    last  = frame.cells;
+
+    flushPending();
+    encodeImage(frame, rect);
+    pendingDelay = delayCs;
+
+    // What the viewer will show once this frame is disposed of.
+    for (int r = rect.row0; r < rect.row0 + rect.rows; ++r) {
+        uint8_t* dst       = &canvas[(size_t)r * cols + rect.col0];
+        const uint8_t* src = &frame.cells[(size_t)r * cols + rect.col0];
+        if (disposal == Disposal::Keep)
+            std::copy(src, src + rect.cols, dst);
+        else if (disposal == Disposal::Background)
+            std::fill(dst, dst + rect.cols, 0);
+        // Previous: the canvas is left as it was.
+    }
+}
+
+// Image descriptor + LZW data for 'rect', kept in 'pending' until
+// the frame's delay is known.
+void GifRecorder::encodeImage(const Frame& frame, const Rect& rect) {
+    pending.clear();
+    pending.push_back(0x2C);
+    put16(pending, rect.col0 * scale);
+    put16(pending, rect.row0 * scale);
+    put16(pending, rect.cols * scale);
+    put16(pending, rect.rows * scale);
+    pending.push_back(0);  // no local color table, not interlaced
+
+    const uint8_t maxIndex = (uint8_t)((1 << colorBits) - 1);
+    LzwEncoder lzw(std::max(2, colorBits), pending);
+    for (int r = rect.row0; r < rect.row0 + rect.rows; ++r) {
+        const uint8_t* cells = &frame.cells[(size_t)r * cols + rect.col0];
+        for (int dy = 0; dy < scale; ++dy)
+            for (int c = 0; c < rect.cols; ++c)
+                for (int dx = 0; dx < scale; ++dx) lzw.put(std::min(cells[c], maxIndex));
+    }
+    lzw.finish();
+}
+
+// Graphic control extension (disposal + delay), then the image.
+void GifRecorder::flushPending() {
+    if (pending.empty())
+        return;
+    uint8_t gce[8] = {0x21, 0xF9, 0x04, (uint8_t)((int)disposal << 2), (uint8_t)(pendingDelay & 0xFF),
+                      (uint8_t)(pendingDelay >> 8), 0, 0};
+    write(out, gce, sizeof gce);
+    write(out, pending.data(), pending.size());
+    pending.clear();
+}
+
+void GifRecorder::close() {
+    flushPending();
+    const uint8_t trailer = 0x3B;
+    write(out, &trailer, 1);
+
+    FILE* f = out;
+    out     = nullptr;
+    if (!closeOutput(f, target)) {
+        throw std::runtime_error("closing '" + target + "' failed");
+    }
+}
@@ -0,0 +1,100 @@
+#include <sys/mman.h>
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "../includes/HaloTransport.hpp"
+
+// --------------------------------------------------------------
+// Each ring is laid out as:
+//   [ Ring header (head, tail) ][ slot 0 ][ slot 1 ] ... [ slot depth-1 ]
+// and rings are packed back to back in one shared mapping, after a
+// single cache line holding the abort flag.
+// --------------------------------------------------------------
+ShmRingTransport::ShmRingTransport(int channels, size_t slotBytes, int depth)
+    : channels(channels), slotBytes(slotBytes), depth(depth) {
+    if (channels <= 0 || depth <= 0) {
+        throw std::invalid_argument("ShmRingTransport needs at least one channel and slot");
+    }
+
+    ringBytes   = (sizeof(Ring) + slotBytes * depth + 63) / 64 * 64;
+    mappedBytes = sizeof(Counter) + ringBytes * channels;
+
+    void* p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("ShmRingTransport: mmap failed");
+    }
+    base = static_cast<uint8_t*>(p);
+
+    // Placed through the accessors, so the layout lives in one place.
+    new (aborted()) Counter;
+    aborted()->value.store(0, std::memory_order_relaxed);
+
+    for (int c = 0; c < channels; ++c) {
+        Ring* r = new (ring(c)) Ring;
+        r->head.value.store(0, std::memory_order_relaxed);
+        r->tail.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+ShmRingTransport::~ShmRingTransport() {
+    munmap(base, mappedBytes);
+}
+
+ShmRingTransport::Counter* ShmRingTransport::aborted() const {
+    return reinterpret_cast<Counter*>(base);
+}
+
+ShmRingTransport::Ring* ShmRingTransport::ring(int channel) const {
+    return reinterpret_cast<Ring*>(base + sizeof(Counter) + ringBytes * channel);
+}
+
+uint8_t* ShmRingTransport::slot(int channel, uint64_t seq) const {
+    return reinterpret_cast<uint8_t*>(ring(channel)) + sizeof(Ring) + slotBytes * (seq % depth);
+}
+
+void ShmRingTransport::abort() {
+    aborted()->value.store(1, std::memory_order_release);
+}
+
+void ShmRingTransport::checkAborted() const {
+    if (aborted()->value.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ShmRingTransport: run aborted by another worker");
+    }
+}
+
+// --------------------------------------------------------------
+// send(): wait for a free slot, copy, then publish with a release
+// store so the consumer sees the payload before the new head.
+// --------------------------------------------------------------
+void ShmRingTransport::send(int channel, const uint8_t* data, size_t bytes) {
+    Ring* r       = ring(channel);
+    uint64_t head = r->head.value.load(std::memory_order_relaxed);
+
+    while (head - r->tail.value.load(std::memory_order_acquire) >= (uint64_t)depth) {
+        checkAborted();
+        std::this_thread::yield();  // receiver is a full ring behind
+    }
+
+    std::memcpy(slot(channel, head), data, bytes);
+    r->head.value.store(head + 1, std::memory_order_release);
+}
+
+// --------------------------------------------------------------
+// recv(): wait until the producer has published a message, copy it
+// out, then hand the slot back by advancing tail.
+// --------------------------------------------------------------
+void ShmRingTransport::recv(int channel, uint8_t* data, size_t bytes) {
+    Ring* r       = ring(channel);
+    uint64_t tail = r->tail.value.load(std::memory_order_relaxed);
+
+    while (r->head.value.load(std::memory_order_acquire) == tail) {
+        checkAborted();
+        std::this_thread::yield();  // halo not produced yet
+    }
+
+    std::memcpy(data, slot(channel, tail), bytes);
+    r->tail.value.store(tail + 1, std::memory_order_release);
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <cstring>
+
+#include "../includes/History.hpp"
+
+// Delta tiles are this many rows tall and one 64-bit word (64 cells) wide.
+static const int TILE_ROWS = 32;
+
+// --------------------------------------------------------------
+// Varints (LEB128): 7 bits per byte, high bit = "more follows".
+// --------------------------------------------------------------
+static void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+static uint64_t getVarint(const uint8_t*& p) {
+    uint64_t v = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            return v;
+    }
+}
+
+// --------------------------------------------------------------
+// Zero-run RLE over bytes:
+//   repeat { varint zeroRun, varint literalCount, literal bytes }
+// until 'n' bytes have been described. Bit-packed Life boards and
+// especially XOR deltas are mostly zero bytes, so this is small.
+// --------------------------------------------------------------
+static void rleEncode(const uint8_t* src, size_t n, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < n) {
+        size_t zeros = 0;
+        while (i + zeros < n && src[i + zeros] == 0) ++zeros;
+        i += zeros;
+
+        // A literal run ends at the next pair of zero bytes (a single
+        // zero is cheaper to keep inline than to start a new run).
+        size_t lit = 0;
+        while (i + lit < n && !(src[i + lit] == 0 && (i + lit + 1 >= n || src[i + lit + 1] == 0))) ++lit;
+
+        putVarint(out, zeros);
+        putVarint(out, lit);
+        out.insert(out.end(), src + i, src + i + lit);
+        i += lit;
+    }
+}
+
+// Decode 'n' bytes and XOR them into 'dst' (XOR into zeros = copy).
+static void rleDecodeXor(const uint8_t*& p, uint8_t* dst, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        i += getVarint(p);
+        size_t lit = getVarint(p);
+        for (size_t k = 0; k < lit; ++k) dst[i + k] ^= p[k];
+        p += lit;
+        i += lit;
+    }
+}
+
+History::History(int rows, int cols, size_t maxBytes, int keyframeInterval)
+    : rows(rows),
+      cols(cols),
+      wordsPerRow((cols + 63) / 64),
+      tileRows((rows + TILE_ROWS - 1) / TILE_ROWS),
+      maxBytes(maxBytes),
+      keyframeInterval(keyframeInterval < 1 ? 1 : keyframeInterval) {
+}
+
+// Same packing as GridView::rowBits(), so bit boards copy straight in.
+void History::pack(const GridView& grid, Packed& out) const {
+    out.resize((size_t)rows * wordsPerRow);
+    for (int r = 0; r < rows; ++r) grid.rowBits(r, &out[(size_t)r * wordsPerRow]);
+}
+
+void History::unpack(const Packed& packed, Grid& out) const {
+    out.assign(rows, std::vector<int>(cols, 0));
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) out[r][c] = (packed[(size_t)r * wordsPerRow + c / 64] >> (c & 63)) & 1;
+}
+
+// --------------------------------------------------------------
+// record(): append a keyframe or a delta against 'last'.
+// --------------------------------------------------------------
+void History::record(const GridView& grid, uint64_t generation, bool isEdit) {
+    // Recording after a rewind abandons the old future.
+    if (!entries.empty() && cursor + 1 < entries.size()) {
+        for (size_t i = cursor + 1; i < entries.size(); ++i) bytes -= entries[i].data.size();
+        entries.erase(entries.begin() + cursor + 1, entries.end());
+        sinceKeyframe = 0;
+        for (size_t i = cursor; !entries[i].isKeyframe; --i) ++sinceKeyframe;
+    }
+
+    pack(grid, now);
+
+    Entry e{generation, isEdit, false, {}};
+    if (entries.empty() || sinceKeyframe + 1 >= keyframeInterval) {
+        e.isKeyframe = true;
+        rleEncode(reinterpret_cast<const uint8_t*>(now.data()), now.size() * sizeof(uint64_t), e.data);
+        sinceKeyframe = 0;
+    } else {
+        // Delta: [varint changedTiles] then per tile
+        //        [varint tile index gap][RLE of the tile's XOR bytes]
+        std::vector<uint8_t> body;
+        std::vector<uint64_t> tile;
+        size_t changed = 0, prevTile = 0;
+        for (int tr = 0; tr < tileRows; ++tr) {
+            int r0 = tr * TILE_ROWS, r1 = std::min(rows, r0 + TILE_ROWS);
+            for (int w = 0; w < wordsPerRow; ++w) {
+                tile.clear();
+                bool any = false;
+                for (int r = r0; r < r1; ++r) {
+                    uint64_t x = now[(size_t)r * wordsPerRow + w] ^ last[(size_t)r * wordsPerRow + w];
+                    tile.push_back(x);
+                    any |= x != 0;
+                }
+                if (!any)
+                    continue;
+                size_t index = (size_t)tr * wordsPerRow + w;
+                putVarint(body, index - prevTile);
+                rleEncode(reinterpret_cast<const uint8_t*>(tile.data()), tile.size() * sizeof(uint64_t), body);
+                prevTile = index;
+                ++changed;
+            }
+        }
+        putVarint(e.data, changed);
+        e.data.insert(e.data.end(), body.begin(), body.end());
+        ++sinceKeyframe;
+    }
+
+    bytes += e.data.size();
+    entries.push_back(std::move(e));
+    cursor = entries.size() - 1;
+    last.swap(now);
+    evict();
+}
+
+// --------------------------------------------------------------
+// evict(): drop whole keyframe segments from the front while over
+// budget. Never drops the segment holding the cursor.
+// --------------------------------------------------------------
+void History::evict() {
+    while (bytes > maxBytes) {
+        size_t next = 1;
+        while (next < entries.size() && !entries[next].isKeyframe) ++next;
+        if (next >= entries.size() || next > cursor)
+            return;  // only one segment left (or it is in use)
+        for (size_t i = 0; i < next; ++i) bytes -= entries[i].data.size();
+        entries.erase(entries.begin(), entries.begin() + next);
+        cursor -= next;
+    }
+}
+
+// --------------------------------------------------------------
+// reconstruct(): nearest keyframe at or before 'index', then apply
+// deltas forward.
+// --------------------------------------------------------------
+void History::reconstruct(size_t index, Packed& out) const {
+    size_t key = index;
+    while (!entries[key].isKeyframe) --key;
+
+    out.assign((size_t)rows * wordsPerRow, 0);
+    uint8_t* bytesOut = reinterpret_cast<uint8_t*>(out.data());
+    const uint8_t* p  = entries[key].data.data();
+    rleDecodeXor(p, bytesOut, out.size() * sizeof(uint64_t));
+
+    std::vector<uint64_t> tile(TILE_ROWS);
+    for (size_t i = key + 1; i <= index; ++i) {
+        p              = entries[i].data.data();
+        size_t changed = getVarint(p);
+        size_t tileIdx = 0;
+        for (size_t t = 0; t < changed; ++t) {
+            tileIdx += getVarint(p);
+            int tr = tileIdx / wordsPerRow, w = tileIdx % wordsPerRow;
+            int r0 = tr * TILE_ROWS, r1 = std::min(rows, r0 + TILE_ROWS);
+
+            std::fill(tile.begin(), tile.end(), 0);
+            rleDecodeXor(p, reinterpret_cast<uint8_t*>(tile.data()), (r1 - r0) * sizeof(uint64_t));
+            for (int r = r0; r < r1; ++r) out[(size_t)r * wordsPerRow + w] ^= tile[r - r0];
+        }
+    }
+}
+
+bool History::seek(uint64_t generation, Grid& out) {
+    for (size_t i = entries.size(); i-- > 0;) {
+        if (entries[i].generation == generation) {
+            reconstruct(i, last);
+            cursor = i;
+            unpack(last, out);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool History::undo(Grid& out, uint64_t& generation) {
+    if (entries.empty() || cursor == 0)
+        return false;
+    --cursor;
+    reconstruct(cursor, last);
+    unpack(last, out);
+    generation = entries[cursor].generation;
+    return true;
+}
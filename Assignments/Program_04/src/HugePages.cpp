@@ -0,0 +1,231 @@
+#include <sys/mman.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+#include "../includes/HugePages.hpp"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace {
+
+const size_t MB2 = size_t(1) << 21;
+const size_t GB1 = size_t(1) << 30;
+
+struct Block {
+    void* base;  // what mmap returned
+    size_t length;
+    HugePages::Size size;
+    size_t bytes;  // what was asked for
+};
+
+std::atomic<int> wanted{(int)HugePages::Size::Normal};
+std::mutex lock;                       // guards the four below
+std::map<const void*, Block> blocks;   // by the pointer handed out
+size_t live[4]    = {0, 0, 0, 0};
+size_t waste      = 0;
+size_t fallbacks = 0;
+
+size_t roundUp(size_t n, size_t to) {
+    return (n + to - 1) / to * to;
+}
+
+// THP can be switched off system-wide ("[never]"); madvise() then
+// still succeeds but does nothing, so check first.
+bool transparentAvailable() {
+    std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string line;
+    return std::getline(in, line) && line.find("[never]") == std::string::npos;
+}
+
+void* mapAnon(size_t length, int extraFlags) {
+    void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+// Try one page size; fills 'out' and returns true on success.
+bool tryMap(HugePages::Size size, size_t bytes, Block& out, void*& aligned) {
+    switch (size) {
+        case HugePages::Size::Huge1G:
+        case HugePages::Size::Huge2M: {
+#ifdef MAP_HUGETLB
+            const bool giga     = size == HugePages::Size::Huge1G;
+            const size_t length = roundUp(bytes, giga ? GB1 : MB2);
+            if (length - bytes > bytes / HugePages::MAX_WASTE_DIVISOR)
+                return false;  // mostly empty reserved pages
+            void* p             = mapAnon(length, MAP_HUGETLB | ((giga ? 30 : 21) << MAP_HUGE_SHIFT));
+            if (!p)
+                return false;
+            out     = {p, length, size, bytes};
+            aligned = p;  // hugetlb mappings are aligned to their page size
+            return true;
+#else
+            return false;
+#endif
+        }
+        case HugePages::Size::Transparent: {
+#ifdef MADV_HUGEPAGE
+            if (!transparentAvailable())
+                return false;
+            // Over-map by one huge page and trim, so the block starts on
+            // a 2 MB boundary and every 2 MB of it can be one page.
+            const size_t length = roundUp(bytes, MB2);
+            char* p             = static_cast<char*>(mapAnon(length + MB2, 0));
+            if (!p)
+                return false;
+            char* start = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(p), MB2));
+            if (start > p)
+                munmap(p, start - p);
+            munmap(start + length, p + MB2 - start);
+            if (madvise(start, length, MADV_HUGEPAGE) != 0) {
+                munmap(start, length);
+                return false;
+            }
+            out     = {start, length, size, bytes};
+            aligned = start;
+            return true;
+#else
+            return false;
+#endif
+        }
+        case HugePages::Size::Normal: {
+            const size_t length = roundUp(bytes, 4096);
+            void* p             = mapAnon(length, 0);
+            if (!p)
+                return false;
+            out     = {p, length, size, bytes};
+            aligned = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+HugePages::Size HugePages::parse(const std::string& name) {
+    if (name == "off" || name == "none" || name.empty())
+        return Size::Normal;
+    if (name == "thp")
+        return Size::Transparent;
+    if (name == "2M" || name == "2m")
+        return Size::Huge2M;
+    if (name == "1G" || name == "1g")
+        return Size::Huge1G;
+    throw std::invalid_argument("hugePages: unknown page size '" + name + "' (off, thp, 2M, 1G)");
+}
+
+const char* HugePages::name(Size size) {
+    switch (size) {
+        case Size::Transparent:
+            return "thp";
+        case Size::Huge2M:
+            return "2M";
+        case Size::Huge1G:
+            return "1G";
+        default:
+            return "off";
+    }
+}
+
+void HugePages::request(Size size) {
+    wanted = (int)size;
+}
+
+HugePages::Size HugePages::requested() {
+    return (Size)wanted.load();
+}
+
+// --------------------------------------------------------------
+// allocate(): small blocks from operator new; big ones mapped with
+// the requested page size, falling back one size at a time.
+// --------------------------------------------------------------
+void* HugePages::allocate(size_t bytes) {
+    if (bytes < MIN_BYTES)
+        return ::operator new(bytes);
+
+    const Size want = requested();
+    Block block;
+    void* p = nullptr;
+    for (int s = (int)want; s >= 0 && !p; --s) {
+        if (!tryMap((Size)s, bytes, block, p))
+            p = nullptr;
+    }
+    if (!p)
+        throw std::bad_alloc();
+
+    std::lock_guard<std::mutex> hold(lock);
+    blocks[p] = block;
+    live[(int)block.size] += block.length;
+    waste += block.length - bytes;
+    fallbacks += block.size != want;
+    return p;
+}
+
+void HugePages::release(void* p, size_t bytes) {
+    if (!p)
+        return;
+    if (bytes < MIN_BYTES) {
+        ::operator delete(p);
+        return;
+    }
+    Block block;
+    {
+        std::lock_guard<std::mutex> hold(lock);
+        auto it = blocks.find(p);
+        if (it == blocks.end())
+            return;
+        block = it->second;
+        live[(int)block.size] -= block.length;
+        waste -= block.length - block.bytes;
+        blocks.erase(it);
+    }
+    munmap(block.base, block.length);
+}
+
+HugePages::Size HugePages::backing(const void* p) {
+    std::lock_guard<std::mutex> hold(lock);
+    auto it = blocks.find(p);
+    return it == blocks.end() ? Size::Normal : it->second.size;
+}
+
+HugePages::Usage HugePages::usage() {
+    std::lock_guard<std::mutex> hold(lock);
+    Usage u;
+    for (int s = 0; s < 4; ++s) u.bytes[s] = live[s];
+    u.waste     = waste;
+    u.blocks    = blocks.size();
+    u.fallbacks = fallbacks;
+    return u;
+}
+
+std::string HugePages::report() {
+    Usage u         = usage();
+    std::string out = std::string("requested ") + name(requested()) + "; mapped";
+    bool any        = false;
+    for (int s = 3; s >= 0; --s) {
+        if (!u.bytes[s])
+            continue;
+        char line[64];
+        std::snprintf(line, sizeof(line), "%s %.1f MB %s", any ? "," : "", u.bytes[s] / 1048576.0, name((Size)s));
+        out += line;
+        any = true;
+    }
+    if (!any)
+        out += " nothing";
+    else {
+        char line[48];
+        std::snprintf(line, sizeof(line), ", %.1f MB rounding", u.waste / 1048576.0);
+        out += line;
+    }
+    if (u.fallbacks)
+        out += " (" + std::to_string(u.fallbacks) + " fallbacks)";
+    return out;
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstring>
+
+#include "../includes/IdleDetector.hpp"
+
+IdleDetector::IdleDetector(int maxPeriod, int confirm)
+    : maxPeriod(std::max(1, maxPeriod)), confirm(std::max(1, confirm)), hashes(this->maxPeriod + 1) {}
+
+void IdleDetector::reset() {
+    seen      = 0;
+    candidate = 0;
+    matched   = 0;
+    confirmed = 0;
+    frames.clear();
+}
+
+// FNV-style, one 64-bit word per multiply: two int cells, eight
+// byte cells or 64 bit-packed cells, whichever the view holds. Views
+// of one board in different formats hash differently, which only
+// matters if a run switched formats mid-cycle.
+uint64_t IdleDetector::hash(const GridView& grid) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    const int cols = grid.cols();
+    for (int r = 0; r < grid.rows(); ++r) {
+        const char* row = grid.format() == GridView::Format::Bits    ? (const char*)grid.bitRow(r)
+                          : grid.format() == GridView::Format::Bytes ? (const char*)grid.byteRow(r)
+                                                                     : (const char*)grid.intRow(r);
+        size_t n = grid.format() == GridView::Format::Bits    ? (cols + 63) / 64 * 8
+                   : grid.format() == GridView::Format::Bytes ? cols
+                                                              : cols * sizeof(int);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, row + i, sizeof word);
+            h = (h ^ word) * 0x100000001b3ull;
+        }
+        for (; i < n; ++i) h = (h ^ (uint8_t)row[i]) * 0x100000001b3ull;
+        h = (h ^ 0xff) * 0x100000001b3ull;  // row boundary
+    }
+    return h;
+}
+
+int IdleDetector::observe(const GridView& grid, uint64_t generation) {
+    if (confirmed)
+        return confirmed;
+
+    const size_t ring = hashes.size();
+    const uint64_t h  = hash(grid);
+    if (candidate && hashes[(seen - candidate) % ring] == h) {
+        ++matched;
+    } else {
+        candidate = 0;
+        matched   = 0;
+        frames.clear();
+        for (int p = 1; p <= maxPeriod && (uint64_t)p <= seen; ++p) {
+            if (hashes[(seen - p) % ring] == h) {
+                candidate = p;
+                matched   = 1;
+                break;
+            }
+        }
+    }
+    hashes[seen % ring] = h;
+    ++seen;
+    if (!candidate)
+        return 0;
+
+    // The last candidate + 1 boards: one cycle plus the board one
+    // period before the newest, for the exact check.
+    if (frames.size() > (size_t)candidate) {
+        // Reuse the oldest board's storage for the newest.
+        std::rotate(frames.begin(), frames.begin() + 1, frames.end());
+        grid.copyTo(frames.back());
+    } else {
+        frames.emplace_back();
+        grid.copyTo(frames.back());
+    }
+
+    if (matched >= (uint64_t)confirm * candidate && frames.size() == (size_t)candidate + 1) {
+        if (frames.front() != frames.back()) {  // hash collision
+            reset();
+            return 0;
+        }
+        frames.erase(frames.begin());
+        start     = generation + 1 - candidate;
+        confirmed = candidate;
+    }
+    return confirmed;
+}
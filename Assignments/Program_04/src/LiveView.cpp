@@ -0,0 +1,172 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "../includes/LiveView.hpp"
+
+// Round the header up so the bit payload is 64-byte aligned.
+static size_t payloadOffset() {
+    return (sizeof(LiveViewHeader) + 63) / 64 * 64;
+}
+
+// --------------------------------------------------------------
+// Publisher
+// --------------------------------------------------------------
+LiveViewPublisher::LiveViewPublisher(const std::string& name, int rows, int cols, bool replace) : name(name) {
+    uint32_t wordsPerRow = (cols + 63) / 64;
+    bytes                = payloadOffset() + (size_t)rows * wordsPerRow * sizeof(uint64_t);
+
+    // O_EXCL: two writers on one seqlock would corrupt each other.
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST && replace) {
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0 && errno == EEXIST) {
+        throw std::runtime_error("LiveViewPublisher: " + name +
+                                 " already exists (another run is publishing, or a crashed one left it); "
+                                 "pick another name or pass liveViewReplace=true");
+    }
+    if (fd < 0) {
+        throw std::runtime_error("LiveViewPublisher: shm_open failed for " + name + ": " + std::strerror(errno));
+    }
+    if (ftruncate(fd, bytes) != 0) {
+        close(fd);
+        throw std::runtime_error("LiveViewPublisher: ftruncate failed");
+    }
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps the segment alive
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("LiveViewPublisher: mmap failed");
+    }
+
+    header = new (p) LiveViewHeader;
+    header->magic.store(0, std::memory_order_relaxed);
+    header->seq.store(0, std::memory_order_relaxed);
+    header->generation.store(0, std::memory_order_relaxed);
+    header->wordsPerRow = wordsPerRow;
+    header->rows        = rows;
+    header->cols        = cols;
+    header->magic.store(LiveViewHeader::MAGIC, std::memory_order_release);  // last: marks the header valid
+    bits                = reinterpret_cast<uint64_t*>(static_cast<uint8_t*>(p) + payloadOffset());
+}
+
+LiveViewPublisher::~LiveViewPublisher() {
+    munmap(header, bytes);
+    shm_unlink(name.c_str());
+}
+
+// --------------------------------------------------------------
+// publish(): classic seqlock write side.
+//   seq odd  → readers know a write is in progress
+//   seq even → frame is complete
+// --------------------------------------------------------------
+// The shared bits use the GridView::rowBits() layout, so rows are
+// packed straight into shared memory (a plain copy for bit boards).
+void LiveViewPublisher::publish(const GridView& grid, uint64_t generation) {
+    const int rows  = header->rows;
+    const int cols  = header->cols;
+    const int words = header->wordsPerRow;
+
+    uint64_t seq = header->seq.load(std::memory_order_relaxed);
+    header->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::vector<uint64_t> line(grid.cols() == cols ? 0 : (grid.cols() + 63) / 64);
+    for (int r = 0; r < rows && r < grid.rows(); ++r) {
+        uint64_t* out = bits + (size_t)r * words;
+        if (line.empty()) {
+            grid.rowBits(r, out);
+            continue;
+        }
+        grid.rowBits(r, line.data());  // board of another width: clip
+        for (int w = 0; w < words; ++w) out[w] = w < (int)line.size() ? line[w] : 0;
+        if (cols % 64 && grid.cols() > cols)
+            out[words - 1] &= (1ull << (cols % 64)) - 1;
+    }
+    header->generation.store(generation, std::memory_order_relaxed);
+
+    header->seq.store(seq + 2, std::memory_order_release);
+}
+
+// --------------------------------------------------------------
+// Reader
+// --------------------------------------------------------------
+LiveViewReader::LiveViewReader(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("LiveViewReader: no live view named " + name);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < payloadOffset()) {
+        close(fd);
+        throw std::runtime_error("LiveViewReader: segment too small");
+    }
+    bytes   = st.st_size;
+    void* p = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("LiveViewReader: mmap failed");
+    }
+
+    header = static_cast<const LiveViewHeader*>(p);
+    bits   = reinterpret_cast<const uint64_t*>(static_cast<const uint8_t*>(p) + payloadOffset());
+    if (header->magic.load(std::memory_order_acquire) != LiveViewHeader::MAGIC ||
+        payloadOffset() + (size_t)header->rows * header->wordsPerRow * sizeof(uint64_t) > bytes) {
+        munmap(p, bytes);
+        throw std::runtime_error("LiveViewReader: not a live view segment");
+    }
+    scratch.resize((size_t)header->rows * header->wordsPerRow);
+}
+
+LiveViewReader::~LiveViewReader() {
+    munmap(const_cast<LiveViewHeader*>(header), bytes);
+}
+
+// --------------------------------------------------------------
+// read(): seqlock read side. Copy the packed frame, then check that
+// 'seq' did not move. Unpacking happens outside the retry loop so
+// a slow viewer holds the retry window as short as possible.
+// A publisher killed mid-frame leaves 'seq' odd for good, so the
+// retries stop after READ_TIMEOUT.
+// --------------------------------------------------------------
+bool LiveViewReader::read(std::vector<std::vector<int>>& grid, uint64_t& generation) {
+    const auto deadline = std::chrono::steady_clock::now() + READ_TIMEOUT;
+    stuck               = false;
+    for (;;) {
+        uint64_t before = header->seq.load(std::memory_order_acquire);
+        if (before == 0)
+            return false;  // nothing published yet
+        if (before & 1) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                stuck = true;
+                return false;
+            }
+            std::this_thread::yield();  // writer is mid-frame
+            continue;
+        }
+
+        std::memcpy(scratch.data(), bits, scratch.size() * sizeof(uint64_t));
+        generation = header->generation.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->seq.load(std::memory_order_relaxed) == before)
+            break;
+    }
+
+    const int rows  = header->rows;
+    const int cols  = header->cols;
+    const int words = header->wordsPerRow;
+    grid.assign(rows, std::vector<int>(cols, 0));
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) grid[r][c] = (scratch[(size_t)r * words + c / 64] >> (c & 63)) & 1;
+    return true;
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "../includes/OffscreenScreen.hpp"
+
+OffscreenScreen::OffscreenScreen(uint32_t* pixels, int width, int height, int cellSize, int stride)
+    : pixels(pixels), width(width), height(height), cellSize(cellSize), stride(stride ? stride : width) {
+    if (!pixels || width <= 0 || height <= 0 || cellSize <= 0 || this->stride < width) {
+        throw std::invalid_argument("OffscreenScreen: bad framebuffer geometry");
+    }
+    pack(Palette::mono(), cellLut);
+}
+
+void OffscreenScreen::setPalette(const Palette& cellPalette) {
+    pack(cellPalette, cellLut);
+}
+
+uint32_t OffscreenScreen::rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    const uint8_t bytes[4] = {r, g, b, a};
+    uint32_t px;
+    std::memcpy(&px, bytes, sizeof px);
+    return px;
+}
+
+void OffscreenScreen::pack(const Palette& palette, uint32_t lut[256]) {
+    for (int i = 0; i < 256; ++i) {
+        Rgb c  = palette[(uint8_t)i];
+        lut[i] = rgba(c.r, c.g, c.b);
+    }
+}
+
+// --------------------------------------------------------------
+// fillSpan(): n pixels of one color, four per 16-byte vector store
+// (GCC/Clang vector extensions), then the remainder one by one.
+// --------------------------------------------------------------
+static void fillSpan(uint32_t* p, int n, uint32_t color) {
+    typedef uint32_t Quad __attribute__((vector_size(16)));
+    const Quad v = {color, color, color, color};
+    int i        = 0;
+    for (; i + 4 <= n; i += 4) std::memcpy(p + i, &v, sizeof v);
+    for (; i < n; ++i) p[i] = color;
+}
+
+// --------------------------------------------------------------
+// widen(): one color per cell → cellSize pixels per cell, clipped at
+// 'width'. cellSize 1 is a copy and 2 packs two cells per vector
+// store; larger cells are one fillSpan() each.
+// --------------------------------------------------------------
+static void widen(uint32_t* p, const uint32_t* colors, int cells, int cellSize, int width) {
+    int c = 0;
+    if (cellSize == 1) {
+        std::memcpy(p, colors, (size_t)std::min(cells, width) * 4);
+        return;
+    }
+    if (cellSize == 2) {
+        typedef uint32_t Quad __attribute__((vector_size(16)));
+        for (; c + 2 <= cells && 2 * c + 4 <= width; c += 2) {
+            const Quad v = {colors[c], colors[c], colors[c + 1], colors[c + 1]};
+            std::memcpy(p + 2 * c, &v, sizeof v);
+        }
+    }
+    for (; c < cells; ++c) {
+        int x0 = c * cellSize;
+        fillSpan(p + x0, std::min(cellSize, width - x0), colors[c]);
+    }
+}
+
+void OffscreenScreen::drawStates(const GridView& grid, const uint32_t lut[256]) const {
+    const uint32_t background = lut[0];
+
+    // Cells that are at least partly inside the buffer.
+    int shownRows = std::min(grid.rows(), (height + cellSize - 1) / cellSize);
+    int shownCols = std::min(grid.cols(), (width + cellSize - 1) / cellSize);
+
+    std::vector<uint8_t> states(shownCols);
+    std::vector<uint32_t> colors(shownCols);
+    for (int r = 0; r < shownRows; ++r) {
+        uint32_t* line = pixels + (size_t)r * cellSize * stride;
+
+        grid.rowStates(r, 0, shownCols, states.data());
+        for (int c = 0; c < shownCols; ++c) colors[c] = lut[states[c]];
+
+        if (cellSize >= MERGE_CELL_SIZE) {
+            // One span per run of equal-colored cells.
+            for (int c = 0; c < shownCols;) {
+                int end = c + 1;
+                while (end < shownCols && colors[end] == colors[c]) ++end;
+                int x0 = c * cellSize, x1 = std::min(end * cellSize, width);
+                fillSpan(line + x0, x1 - x0, colors[c]);
+                c = end;
+            }
+        } else {
+            widen(line, colors.data(), shownCols, cellSize, width);
+        }
+        int drawn = std::min(shownCols * cellSize, width);
+        fillSpan(line + drawn, width - drawn, background);
+
+        int tall = std::min(cellSize, height - r * cellSize);
+        for (int dy = 1; dy < tall; ++dy) std::memcpy(line + (size_t)dy * stride, line, (size_t)width * 4);
+    }
+
+    for (int y = shownRows * cellSize; y < height; ++y) fillSpan(pixels + (size_t)y * stride, width, background);
+}
+
+void OffscreenScreen::render(const GridView& grid) const {
+    drawStates(grid, cellLut);
+}
+
+void OffscreenScreen::renderHeatmap(const GridView& values, const Palette& palette) const {
+    uint32_t lut[256];
+    pack(palette, lut);
+    drawStates(values, lut);
+}
+
+uint64_t OffscreenScreen::hash() const {
+    uint64_t h = 0xcbf29ce484222325ull;  // FNV-1a, one pixel at a time
+    for (int y = 0; y < height; ++y) {
+        const uint32_t* row = pixels + (size_t)y * stride;
+        for (int x = 0; x < width; ++x) {
+            h ^= row[x];
+            h *= 0x100000001b3ull;
+        }
+    }
+    return h;
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <csignal>
+#include <stdexcept>
+#include <string>
+
+#include "../includes/Recorder.hpp"
+
+Recorder::Recorder(int rows, int cols, int every, bool lossless, size_t depth)
+    : rows(rows), cols(cols), every(every < 1 ? 1 : every), lossless(lossless), queue(depth) {
+}
+
+Recorder::~Recorder() {
+    // Subclasses normally finish() first; this is the safety net
+    // for a worker that is still running.
+    if (worker.joinable()) {
+        queue.close();
+        worker.join();
+    }
+}
+
+void Recorder::start() {
+    worker = std::thread([this] { run(); });
+}
+
+// Every 'every'-th generation gets a frame, if one is free.
+Frame* Recorder::slotFor(uint64_t generation) {
+    if (finished || generation % every != 0)
+        return nullptr;
+    Frame* f = queue.acquire(lossless);
+    if (!f) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    f->generation = generation;
+    f->rows       = rows;
+    f->cols       = cols;
+    f->cells.resize((size_t)rows * cols);
+    return f;
+}
+
+void Recorder::checkSize(const GridView& grid) const {
+    if (grid.rows() != rows || grid.cols() != cols) {
+        throw std::invalid_argument("Recorder: got a " + std::to_string(grid.rows()) + "x" +
+                                    std::to_string(grid.cols()) + " board, recording " + std::to_string(rows) +
+                                    "x" + std::to_string(cols));
+    }
+}
+
+bool Recorder::capture(const GridView& grid, uint64_t generation) {
+    checkSize(grid);
+    Frame* f = slotFor(generation);
+    if (!f)
+        return false;
+    uint8_t* out = f->cells.data();
+    for (int r = 0; r < rows; ++r, out += cols) grid.rowAlive(r, 0, cols, out);
+    queue.submit(f);
+    captured.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool Recorder::captureStates(const GridView& grid, uint64_t generation) {
+    checkSize(grid);
+    Frame* f = slotFor(generation);
+    if (!f)
+        return false;
+    uint8_t* out = f->cells.data();
+    for (int r = 0; r < rows; ++r, out += cols) grid.rowStates(r, 0, cols, out);
+    queue.submit(f);
+    captured.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// --------------------------------------------------------------
+// Worker: encode until the queue is closed and empty. After an
+// I/O error frames are still taken (and discarded) so a lossless
+// producer cannot wait forever.
+// --------------------------------------------------------------
+void Recorder::run() {
+    bool failed = false;
+    while (Frame* f = queue.next()) {
+        if (!failed) {
+            try {
+                encode(*f);
+                encoded.fetch_add(1, std::memory_order_relaxed);
+            } catch (const std::exception& ex) {
+                std::lock_guard<std::mutex> guard(errorLock);
+                error  = ex.what();
+                failed = true;
+            }
+        }
+        queue.release(f);
+    }
+    if (!failed) {
+        try {
+            close();
+        } catch (const std::exception& ex) {
+            std::lock_guard<std::mutex> guard(errorLock);
+            error = ex.what();
+        }
+    }
+}
+
+void Recorder::finish() {
+    if (finished)
+        return;
+    finished = true;
+    queue.close();
+    if (worker.joinable())
+        worker.join();
+
+    std::lock_guard<std::mutex> guard(errorLock);
+    if (!error.empty()) {
+        throw std::runtime_error("recording failed: " + error);
+    }
+}
+
+RecorderStats Recorder::stats() const {
+    RecorderStats s;
+    s.captured = captured.load(std::memory_order_relaxed);
+    s.dropped  = dropped.load(std::memory_order_relaxed);
+    s.encoded  = encoded.load(std::memory_order_relaxed);
+    s.bytes    = bytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+void Recorder::write(FILE* out, const void* data, size_t size) {
+    if (fwrite(data, 1, size, out) != size) {
+        throw std::runtime_error("write failed");
+    }
+    bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+FILE* Recorder::openOutput(const std::string& target) {
+    FILE* out = nullptr;
+    if (target == "-") {
+        out = stdout;
+    } else if (!target.empty() && target[0] == '|') {
+        // A dead encoder should surface as a write error, not kill us.
+        std::signal(SIGPIPE, SIG_IGN);
+        out = popen(target.c_str() + 1, "w");
+    } else {
+        out = fopen(target.c_str(), "wb");
+    }
+    if (!out) {
+        throw std::runtime_error("cannot open recording output '" + target + "'");
+    }
+    return out;
+}
+
+bool Recorder::closeOutput(FILE* out, const std::string& target) {
+    if (target == "-")
+        return fflush(out) == 0;
+    if (!target.empty() && target[0] == '|')
+        return pclose(out) == 0;
+    return fclose(out) == 0;
+}
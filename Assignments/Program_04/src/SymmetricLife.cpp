@@ -0,0 +1,121 @@
+#include <cstdlib>
+#include <stdexcept>
+
+#include "../includes/SymmetricLife.hpp"
+
+SymmetricLife::SymmetricLife(int rows, int cols, Symmetry symmetry, LifeRule rule)
+    : rows(rows), cols(cols), sym(symmetry), rule(rule) {
+    checkSymmetry(sym, rows, cols);
+
+    domRows = rows;
+    domCols = cols;
+    if (sym == Symmetry::C2 || sym == Symmetry::D4 || sym == Symmetry::C4 || sym == Symmetry::D8)
+        domRows = (rows + 1) / 2;
+    if (sym == Symmetry::D2 || sym == Symmetry::D4 || sym == Symmetry::C4 || sym == Symmetry::D8)
+        domCols = (cols + 1) / 2;
+    stride = domCols + 2;
+
+    cells.assign((size_t)(domRows + 2) * stride, 0);
+
+    // ----------------------------------------------------------
+    // Every buffer slot is either computed by step() or copied by
+    // refresh() from the computed cell it is an image of.
+    // ----------------------------------------------------------
+    for (int i = 0; i < domRows + 2; ++i) {
+        for (int j = 0; j < stride; ++j) {
+            int r = i - 1, c = j - 1;
+            if (r >= 0 && r < domRows && c >= 0 && c < domCols && inComputed(r, c)) {
+                computed.push_back(i * stride + j);
+                continue;
+            }
+
+            // Off the board → always dead.
+            int src = (r >= 0 && r < rows && c >= 0 && c < cols) ? sourceOf(r, c) : -1;
+            refreshDst.push_back(i * stride + j);
+            refreshSrc.push_back(src);
+        }
+    }
+
+    // ----------------------------------------------------------
+    // Population weights: every board cell is credited to the same
+    // computed cell refresh()/expand() read it from, so summing
+    // state * weight over computed cells counts each board cell once.
+    // ----------------------------------------------------------
+    weight.assign(cells.size(), 0);
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) weight[sourceOf(r, c)]++;
+}
+
+// Buffer index of the computed cell that board cell (r, c) mirrors.
+int SymmetricLife::sourceOf(int r, int c) const {
+    for (auto [ir, ic] : symmetryImages(sym, rows, cols, r, c))
+        if (ir < domRows && ic < domCols && inComputed(ir, ic))
+            return (ir + 1) * stride + ic + 1;
+    throw std::logic_error("SymmetricLife: cell has no image in the fundamental domain");
+}
+
+// D8 only computes the upper triangle of its quadrant; the lower
+// triangle is the diagonal mirror image.
+bool SymmetricLife::inComputed(int r, int c) const {
+    return sym != Symmetry::D8 || c >= r;
+}
+
+void SymmetricLife::refresh(uint8_t* buf) const {
+    for (size_t k = 0; k < refreshDst.size(); ++k) buf[refreshDst[k]] = refreshSrc[k] < 0 ? 0 : buf[refreshSrc[k]];
+}
+
+void SymmetricLife::load(const std::vector<std::vector<int>>& grid) {
+    uint8_t* cur = cells.cur();
+    for (int idx : computed) cur[idx] = grid[idx / stride - 1][idx % stride - 1] != 0;
+    refresh(cur);
+    gen = 0;
+}
+
+// --------------------------------------------------------------
+// randomize(): one random draw per orbit. Some orbits have more
+// than one computed member (e.g. the middle row under C2), so only
+// the lexicographically first member draws and the others copy it.
+// --------------------------------------------------------------
+void SymmetricLife::randomize(double density) {
+    uint8_t* cur = cells.cur();
+    for (int idx : computed) {
+        int r = idx / stride - 1, c = idx % stride - 1;
+        std::pair<int, int> first{r, c};
+        for (auto img : symmetryImages(sym, rows, cols, r, c))
+            if (img.first < domRows && img.second < domCols && inComputed(img.first, img.second) && img < first)
+                first = img;
+
+        if (first == std::make_pair(r, c))
+            cur[idx] = ((double)rand() / RAND_MAX) < density;
+        else
+            cur[idx] = cur[(first.first + 1) * stride + first.second + 1];
+    }
+    refresh(cur);
+    gen = 0;
+}
+
+void SymmetricLife::step() {
+    const uint8_t* in = cells.cur();
+    uint8_t* next     = cells.next();
+    for (int idx : computed) {
+        int n = in[idx - stride - 1] + in[idx - stride] + in[idx - stride + 1] + in[idx - 1] + in[idx + 1] +
+                in[idx + stride - 1] + in[idx + stride] + in[idx + stride + 1];
+        next[idx] = rule.next(in[idx], n);
+    }
+    refresh(next);
+    cells.swap();
+    ++gen;
+}
+
+void SymmetricLife::expand(std::vector<std::vector<int>>& grid) const {
+    grid.assign(rows, std::vector<int>(cols, 0));
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) grid[r][c] = cells.cur()[sourceOf(r, c)];
+}
+
+long SymmetricLife::population() const {
+    long count = 0;
+    const uint8_t* cur = cells.cur();
+    for (int idx : computed) count += cur[idx] * weight[idx];
+    return count;
+}
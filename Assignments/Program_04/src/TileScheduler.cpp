@@ -0,0 +1,270 @@
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "../includes/TileScheduler.hpp"
+
+// Pin the calling thread to one cpu (no-op for cpu < 0).
+static void pinTo(int cpu) {
+    if (cpu < 0)
+        return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// Pins the caller to 'cpu' for as long as it lives, then puts the
+// caller's own affinity mask back.
+struct PinCaller {
+    bool pinned;
+    cpu_set_t saved;
+
+    explicit PinCaller(int cpu) : pinned(cpu >= 0) {
+        if (pinned && pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved) == 0)
+            pinTo(cpu);
+        else
+            pinned = false;
+    }
+    ~PinCaller() {
+        if (pinned)
+            pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+    }
+};
+
+TileScheduler::TileScheduler(int threads, std::vector<int> cpus) {
+    if (threads < 1) {
+        throw std::invalid_argument("TileScheduler: need at least one thread");
+    }
+    if (!cpus.empty() && (int)cpus.size() != threads) {
+        throw std::invalid_argument("TileScheduler: " + std::to_string(cpus.size()) + " cpus for " +
+                                    std::to_string(threads) + " threads");
+    }
+    for (int w = 0; w < threads; ++w) {
+        queues.push_back(std::make_unique<Queue>());
+        if (!cpus.empty()) {
+            queues[w]->cpu  = cpus[w];
+            queues[w]->node = nodeOfCpu(cpus[w]);
+        }
+    }
+
+    // Victims in ring order from each worker, own node first.
+    for (int w = 0; w < threads; ++w) {
+        for (int pass = 0; pass < 2; ++pass)
+            for (int k = 1; k < threads; ++k) {
+                int v = (w + k) % threads;
+                if ((queues[v]->node == queues[w]->node) == (pass == 0))
+                    queues[w]->victims.push_back(v);
+            }
+    }
+
+    for (int w = 1; w < threads; ++w) pool.emplace_back(&TileScheduler::loop, this, w);
+}
+
+TileScheduler::~TileScheduler() {
+    {
+        std::lock_guard<std::mutex> hold(gate);
+        stopping = true;
+    }
+    start.notify_all();
+    for (auto& t : pool) t.join();
+}
+
+// --------------------------------------------------------------
+// take(): the owner pops from the back; otherwise scan the other
+// deques, starting after this worker so thieves spread out (and on
+// this worker's node), and steal from the front.
+// --------------------------------------------------------------
+bool TileScheduler::take(int worker, int& task) {
+    Queue& own = *queues[worker];
+    {
+        std::lock_guard<std::mutex> hold(own.lock);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    if (!stealing)
+        return false;
+    for (int v : own.victims) {
+        Queue& victim = *queues[v];
+        std::lock_guard<std::mutex> hold(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            ++own.stole;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Run tasks until no deque has any left. A task taken is always
+// finished by its taker, so 'remaining' reaching 0 means all done.
+void TileScheduler::drain(int worker) {
+    int task;
+    while (remaining.load(std::memory_order_acquire) > 0 && take(worker, task)) {
+        (*job)(task, worker);
+        ++queues[worker]->ran;
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void TileScheduler::loop(int worker) {
+    pinTo(queues[worker]->cpu);
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> hold(gate);
+            start.wait(hold, [&] { return stopping || epoch != seen; });
+            if (stopping)
+                return;
+            seen = epoch;
+        }
+        drain(worker);
+        {
+            std::lock_guard<std::mutex> hold(gate);
+            if (--active == 0)
+                done.notify_one();
+        }
+    }
+}
+
+void TileScheduler::run(const std::vector<int>& tasks, const std::function<void(int task, int worker)>& fn) {
+    if (tasks.empty())
+        return;
+    ++batches;
+    job = &fn;
+
+    const size_t n = tasks.size(), t = queues.size();
+    if (home) {
+        for (auto& q : queues) q->tasks.clear();
+        for (int task : tasks) queues[(size_t)home(task) % t]->tasks.push_back(task);
+    } else {
+        // Contiguous slices: worker w gets tasks [w*n/T, (w+1)*n/T).
+        for (size_t w = 0; w < t; ++w)
+            queues[w]->tasks.assign(tasks.begin() + w * n / t, tasks.begin() + (w + 1) * n / t);
+    }
+    remaining.store((int)n, std::memory_order_release);
+    dispatch();
+}
+
+void TileScheduler::each(const std::function<void(int worker)>& fn) {
+    const std::function<void(int, int)> once = [&fn](int, int worker) { fn(worker); };
+    job = &once;
+    for (size_t w = 0; w < queues.size(); ++w) queues[w]->tasks.assign(1, (int)w);
+    remaining.store((int)queues.size(), std::memory_order_release);
+    stealing = false;
+    dispatch();
+    stealing = true;
+
+    // Not tasks: keep them out of the stats.
+    for (auto& q : queues) q->ran--;
+}
+
+void TileScheduler::setHomes(std::function<int(int task)> fn) {
+    home = std::move(fn);
+}
+
+// The pool is idle between batches, so the deques and flags above
+// are set up without their locks; 'gate' publishes them.
+void TileScheduler::dispatch() {
+    PinCaller pin(queues[0]->cpu);
+    if (!pool.empty()) {
+        {
+            std::lock_guard<std::mutex> hold(gate);
+            active = (int)pool.size();
+            ++epoch;
+        }
+        start.notify_all();
+    }
+    drain(0);
+
+    // Barrier: the pool has left the batch (so nobody still holds
+    // 'job'), and with it every task is finished.
+    std::unique_lock<std::mutex> hold(gate);
+    done.wait(hold, [&] { return active == 0; });
+    job = nullptr;
+}
+
+TileScheduler::Stats TileScheduler::stats() const {
+    Stats s;
+    s.batches = batches;
+    for (const auto& q : queues) {
+        s.tasks += q->ran;
+        s.steals += q->stole;
+        s.perWorker.push_back(q->ran);
+    }
+    return s;
+}
+
+int TileScheduler::nodeOfCpu(int cpu) {
+    // /sys/devices/system/cpu/cpuN/ holds a "nodeK" link.
+    std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    int node        = 0;
+    if (DIR* d = opendir(dir.c_str())) {
+        while (dirent* e = readdir(d)) {
+            if (std::strncmp(e->d_name, "node", 4) == 0 && std::isdigit((unsigned char)e->d_name[4])) {
+                node = std::atoi(e->d_name + 4);
+                break;
+            }
+        }
+        closedir(d);
+    }
+    return node;
+}
+
+std::vector<int> TileScheduler::parseAffinity(const std::string& spec, int threads) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    std::vector<int> usable;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed))
+            usable.push_back(cpu);
+
+    std::vector<int> cpus;
+    if (spec.empty()) {
+        return cpus;
+    } else if (spec == "compact") {
+        for (int w = 0; w < threads; ++w) cpus.push_back(usable[w % usable.size()]);
+    } else if (spec == "scatter") {
+        // Deal cpus from each node in turn.
+        std::map<int, std::vector<int>> byNode;
+        for (int cpu : usable) byNode[nodeOfCpu(cpu)].push_back(cpu);
+        for (size_t i = 0; (int)cpus.size() < threads; ++i) {
+            for (auto& node : byNode)
+                if ((int)cpus.size() < threads)
+                    cpus.push_back(node.second[i % node.second.size()]);
+        }
+    } else {
+        std::stringstream list(spec);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            int cpu;
+            try {
+                cpu = std::stoi(item);
+            } catch (const std::exception&) {
+                throw std::invalid_argument("affinity: '" + spec + "' is not compact, scatter or a list of cpus");
+            }
+            if (cpu < 0 || cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed)) {
+                throw std::invalid_argument("affinity: cpu " + item + " is not available");
+            }
+            cpus.push_back(cpu);
+        }
+        if ((int)cpus.size() != threads) {
+            throw std::invalid_argument("affinity: " + std::to_string(cpus.size()) + " cpus listed for " +
+                                        std::to_string(threads) + " threads");
+        }
+    }
+    return cpus;
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+
+#include "../includes/TiledLife.hpp"
+
+TiledLife::TiledLife(int r, int c, int threads, bool numa, std::vector<int> cpus)
+    : ConwayLife(r, c), scheduler(threads, std::move(cpus)), numa(numa) {
+    if (numa)
+        scheduler.setHomes([this](int tile) { return ownerOfTile(tile); });
+}
+
+// --------------------------------------------------------------
+// Bands of whole tile rows, so every row has a single owner: worker
+// w owns tile rows [w*R/T, (w+1)*R/T). ownerOfRow() inverts that
+// (the last w whose band starts at or before the row), so tiles are
+// scheduled on the worker that first-touched their rows.
+// --------------------------------------------------------------
+std::pair<int, int> TiledLife::bandOf(int worker) const {
+    const long threads = scheduler.threads();
+    return {(int)(worker * (long)tileRows / threads), (int)((worker + 1) * (long)tileRows / threads)};
+}
+
+int TiledLife::ownerOfRow(int tileRow) const {
+    return tileRows < 1 ? 0 : (int)(((tileRow + 1L) * scheduler.threads() - 1) / tileRows);
+}
+
+int TiledLife::ownerOfTile(int tile) const {
+    return ownerOfRow(tile / tileCols);
+}
+
+// --------------------------------------------------------------
+// sync(): bring the back buffer and tile flags in line with what
+// happened to the board outside step(). A new size (or a step taken
+// by ConwayLife::step(), see below) needs a fresh copy; edits only
+// need their tiles marked as changed, since an active tile never
+// reads the back buffer.
+// --------------------------------------------------------------
+void TiledLife::sync() {
+    const int tr = (rows + TILE - 1) / TILE;
+    const bool fresh = tr != tileRows || (int)changed.size() != tr * tileCols || (int)back.size() != rows ||
+                       (rows > 0 && (int)back[0].size() != cols);
+    if (fresh) {
+        tileRows = tr;
+        if (numa)
+            place();
+        else
+            back = grid;
+        zeros.assign(cols, 0);
+        changed.assign((size_t)tileRows * tileCols, 1);
+        results.assign(changed.size(), TileResult());
+    } else {
+        for (size_t t = 0; t < changed.size(); ++t) changed[t] |= dirty[t];
+    }
+    clearDirty();
+}
+
+// --------------------------------------------------------------
+// place(): every worker copies its band of rows into new vectors,
+// for both buffers. The copy is the first write to those pages, so
+// the kernel puts them on the worker's node. Rows are never
+// reallocated after this (restore() and advance() write into them),
+// until the next resize.
+// --------------------------------------------------------------
+void TiledLife::place() {
+    back.resize(rows);
+    scheduler.each([&](int worker) {
+        auto band = bandOf(worker);
+        int from  = std::min(rows, band.first * TILE);
+        int to    = std::min(rows, band.second * TILE);
+        for (int r = from; r < to; ++r) {
+            std::vector<int> mine(grid[r]);
+            grid[r].swap(mine);
+            back[r] = std::vector<int>(grid[r]);
+        }
+    });
+}
+
+// One tile of the next generation, from 'grid' into 'back'.
+void TiledLife::computeTile(int tile) {
+    const int r0 = tile / tileCols * TILE, r1 = std::min(rows, r0 + TILE);
+    const int c0 = tile % tileCols * TILE, c1 = std::min(cols, c0 + TILE);
+    TileResult res;
+
+    for (int r = r0; r < r1; ++r) {
+        const int* up   = r > 0 ? grid[r - 1].data() : zeros.data();
+        const int* mid  = grid[r].data();
+        const int* down = r + 1 < rows ? grid[r + 1].data() : zeros.data();
+        int* out        = back[r].data();
+
+        // Live cells per column of the 3-row window, sliding along.
+        auto column = [&](int c) { return c < 0 || c >= cols ? 0 : (up[c] == 1) + (mid[c] == 1) + (down[c] == 1); };
+        int left = column(c0 - 1), here = column(c0);
+        for (int c = c0; c < c1; ++c) {
+            int right = column(c + 1);
+            int cell  = mid[c];
+            int next  = rule.next(cell, left + here + right - (cell == 1));
+            res.born += !cell && next;
+            res.died += cell && !next;
+            res.changed |= next != cell;
+            out[c] = next;
+            left   = here;
+            here   = right;
+        }
+    }
+    results[tile] = res;
+}
+
+// --------------------------------------------------------------
+// step(): schedule the active tiles, wait for them (the barrier),
+// then swap buffers and fold the per-tile results in.
+// --------------------------------------------------------------
+void TiledLife::step() {
+    if (heatmapOn) {
+        // The heatmap is updated row by row inside ConwayLife::step().
+        ConwayLife::step();
+        back.clear();  // forces a fresh copy next time
+        return;
+    }
+    sync();
+
+    active.clear();
+    for (int tr = 0; tr < tileRows; ++tr)
+        for (int tc = 0; tc < tileCols; ++tc) {
+            bool near = false;
+            for (int dr = -1; dr <= 1 && !near; ++dr)
+                for (int dc = -1; dc <= 1 && !near; ++dc) {
+                    int r = tr + dr, c = tc + dc;
+                    near  = r >= 0 && r < tileRows && c >= 0 && c < tileCols && changed[(size_t)r * tileCols + c];
+                }
+            if (near)
+                active.push_back(tr * tileCols + tc);
+        }
+
+    scheduler.run(active, [this](int tile, int) { computeTile(tile); });
+
+    // Inactive tiles: 'back' already holds their (unchanged) cells.
+    grid.swap(back);
+    std::fill(changed.begin(), changed.end(), 0);
+    long born = 0, died = 0;
+    for (int t : active) {
+        born += results[t].born;
+        died += results[t].died;
+        changed[t] = results[t].changed;
+    }
+    counters.generation++;
+    counters.population += born - died;
+    counters.births = born;
+    counters.deaths = died;
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "../includes/VideoExporter.hpp"
+
+VideoExporter::Format VideoExporter::parseFormat(const std::string& name) {
+    if (name == "y4m")
+        return Format::Y4M;
+    if (name == "ppm")
+        return Format::PPM;
+    throw std::invalid_argument("unknown video format '" + name + "' (y4m, ppm)");
+}
+
+VideoExporter::VideoExporter(const std::string& target, Format format, int rows, int cols, int scale,
+                             const Palette& palette, int fps, int every, bool lossless)
+    : Recorder(rows, cols, every, lossless),
+      target(target),
+      format(format),
+      scale(std::max(1, scale)),
+      palette(palette),
+      frameWidth(cols * this->scale),
+      frameHeight(rows * this->scale) {
+    if (format == Format::Y4M) {
+        frameWidth += frameWidth & 1;
+        frameHeight += frameHeight & 1;
+    }
+
+    // Full-range BT.601 (JPEG) conversion, once per palette entry.
+    for (int i = 0; i < 256; ++i) {
+        Rgb c     = palette[(uint8_t)i];
+        lumaOf[i] = (uint8_t)std::clamp(0.299 * c.r + 0.587 * c.g + 0.114 * c.b + 0.5, 0.0, 255.0);
+        cbOf[i]   = (uint8_t)std::clamp(128 - 0.168736 * c.r - 0.331264 * c.g + 0.5 * c.b + 0.5, 0.0, 255.0);
+        crOf[i]   = (uint8_t)std::clamp(128 + 0.5 * c.r - 0.418688 * c.g - 0.081312 * c.b + 0.5, 0.0, 255.0);
+    }
+    indexRow.assign(frameWidth, 0);
+
+    out = openOutput(target);
+    if (format == Format::Y4M) {
+        std::string header = "YUV4MPEG2 W" + std::to_string(frameWidth) + " H" + std::to_string(frameHeight) +
+                             " F" + std::to_string(fps) + ":1 Ip A1:1 C420jpeg\n";
+        write(out, header.data(), header.size());
+    }
+    start();
+}
+
+VideoExporter::~VideoExporter() {
+    try {
+        finish();
+    } catch (const std::exception& ex) {
+        std::cerr << "video export: " << ex.what() << std::endl;
+    }
+    if (out)
+        closeOutput(out, target);  // only after a failed encode
+}
+
+void VideoExporter::encode(const Frame& frame) {
+    if (format == Format::Y4M)
+        encodeY4M(frame);
+    else
+        encodePPM(frame);
+}
+
+void VideoExporter::close() {
+    FILE* f = out;
+    out     = nullptr;
+    if (!closeOutput(f, target)) {
+        throw std::runtime_error("closing '" + target + "' failed");
+    }
+}
+
+// Cell row y / scale, widened to pixels. Rows past the board (Y4M
+// padding) are all background.
+const uint8_t* VideoExporter::pixelRow(const Frame& frame, int y) {
+    int r = y / scale;
+    if (r >= frame.rows) {
+        std::fill(indexRow.begin(), indexRow.end(), 0);
+        return indexRow.data();
+    }
+    const uint8_t* cells = &frame.cells[(size_t)r * frame.cols];
+    uint8_t* px          = indexRow.data();
+    for (int c = 0; c < frame.cols; ++c, px += scale) std::fill(px, px + scale, cells[c]);
+    std::fill(indexRow.begin() + frame.cols * scale, indexRow.end(), 0);
+    return indexRow.data();
+}
+
+void VideoExporter::encodePPM(const Frame& frame) {
+    std::string header = "P6\n" + std::to_string(frameWidth) + " " + std::to_string(frameHeight) + "\n255\n";
+    write(out, header.data(), header.size());
+
+    plane.resize((size_t)frameWidth * 3);
+    for (int y = 0; y < frameHeight; ++y) {
+        const uint8_t* idx = pixelRow(frame, y);
+        for (int x = 0; x < frameWidth; ++x) {
+            Rgb c            = palette[idx[x]];
+            plane[3 * x]     = c.r;
+            plane[3 * x + 1] = c.g;
+            plane[3 * x + 2] = c.b;
+        }
+        write(out, plane.data(), plane.size());
+    }
+}
+
+// --------------------------------------------------------------
+// Y4M 4:2:0: a full-size luma plane, then Cb and Cr at half width
+// and half height, each chroma sample the average of a 2x2 block.
+// --------------------------------------------------------------
+void VideoExporter::encodeY4M(const Frame& frame) {
+    static const char tag[] = "FRAME\n";
+    write(out, tag, sizeof tag - 1);
+
+    const int cw = frameWidth / 2, ch = frameHeight / 2;
+    plane.resize((size_t)frameWidth * frameHeight + 2 * (size_t)cw * ch);
+    uint8_t* luma = plane.data();
+    uint8_t* cb   = luma + (size_t)frameWidth * frameHeight;
+    uint8_t* cr   = cb + (size_t)cw * ch;
+
+    std::vector<uint8_t> above(frameWidth);
+    for (int y = 0; y < frameHeight; ++y) {
+        const uint8_t* idx = pixelRow(frame, y);
+        uint8_t* lrow      = luma + (size_t)y * frameWidth;
+        for (int x = 0; x < frameWidth; ++x) lrow[x] = lumaOf[idx[x]];
+
+        if (y % 2 == 0) {
+            std::copy(idx, idx + frameWidth, above.begin());
+            continue;
+        }
+        size_t at = (size_t)(y / 2) * cw;
+        for (int x = 0; x < cw; ++x) {
+            uint8_t a = above[2 * x], b = above[2 * x + 1], c = idx[2 * x], d = idx[2 * x + 1];
+            cb[at + x] = (uint8_t)((cbOf[a] + cbOf[b] + cbOf[c] + cbOf[d] + 2) / 4);
+            cr[at + x] = (uint8_t)((crOf[a] + crOf[b] + crOf[c] + crOf[d] + 2) / 4);
+        }
+    }
+    write(out, plane.data(), plane.size());
+}
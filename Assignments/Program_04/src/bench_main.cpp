@@ -0,0 +1,999 @@
+// --------------------------------------------------------------
+// bench_main.cpp
+// --------------------------------------------------------------
+// Headless benchmark driver. Does not need SDL.
+//
+// Usage:
+//   ./bench suite=distributed rows=512 cols=512 generations=200 workers=8
+//
+// Every suite checks its result against a plain ConwayLife run
+// before printing timings, so a fast-but-wrong engine is reported
+// as a failure instead of a speedup.
+// --------------------------------------------------------------
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "../includes/BitBoard.hpp"
+#include "../includes/Census.hpp"
+#include "../includes/FrameScheduler.hpp"
+#include "../includes/ConwayLife.hpp"
+#include "../includes/DensityPyramid.hpp"
+#include "../includes/DistributedLife.hpp"
+#include "../includes/Engine.hpp"
+#include "../includes/GifRecorder.hpp"
+#include "../includes/HugePages.hpp"
+#include "../includes/IdleDetector.hpp"
+#include "../includes/OffscreenScreen.hpp"
+#include "../includes/RenderPolicy.hpp"
+#include "../includes/SymmetricLife.hpp"
+#include "../includes/TiledLife.hpp"
+#include "../includes/VideoExporter.hpp"
+#include "../includes/argsToJson.hpp"
+#include "../includes/json.hpp"
+
+using namespace std;
+using nlohmann::json;
+
+json defaults = {{"suite", "distributed"}, {"rows", 512}, {"cols", 512}, {"generations", 200},
+                 {"workers", 4},           {"seed", 1},         {"hugePages", "off"}};
+
+// Wall-clock seconds taken by fn().
+static double timeIt(const function<void()>& fn) {
+    auto start = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// --------------------------------------------------------------
+// Suite: distributed
+// Runs DistributedLife with 1..workers processes on the same
+// starting board and reports speedup relative to 1 worker.
+// --------------------------------------------------------------
+static int benchDistributed(const json& params) {
+    int rows = params["rows"], cols = params["cols"];
+    int gens = params["generations"], maxWorkers = params["workers"];
+
+    srand(params["seed"].get<int>());
+    ConwayLife reference(rows, cols);
+
+    double refTime = timeIt([&] {
+        for (int g = 0; g < gens; ++g) reference.step();
+    });
+    cout << "ConwayLife (single process): " << fixed << setprecision(3) << refTime << " s\n";
+
+    double base = 0;
+    cout << "workers  grid   seconds   speedup  identical\n";
+    for (int w = 1; w <= maxWorkers; ++w) {
+        srand(params["seed"].get<int>());
+        DistributedLife dist(rows, cols, w);  // same seed → same board
+
+        double t = timeIt([&] { dist.run(gens); });
+        if (w == 1)
+            base = t;
+
+        bool same = dist.getGrid() == reference.getGrid();
+        cout << setw(7) << w << "  " << setw(2) << dist.workerRows() << "x" << left << setw(3) << dist.workerCols()
+             << right << setw(8) << t << setw(10) << base / t << "  " << (same ? "yes" : "NO") << "\n";
+        if (!same)
+            return 1;
+    }
+    return 0;
+}
+
+// --------------------------------------------------------------
+// Suite: fastforward
+// Checks ConwayLife::advance() against plain step() calls for a
+// short run, then times a jump of 'jump' generations.
+// --------------------------------------------------------------
+static int benchFastForward(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    uint64_t jump = params.value("jump", 1000000ull);
+
+    srand(params["seed"].get<int>());
+    ConwayLife slow(rows, cols);
+    srand(params["seed"].get<int>());
+    ConwayLife fast(rows, cols);
+
+    double stepTime = timeIt([&] {
+        for (int g = 0; g < gens; ++g) slow.step();
+    });
+    double advTime  = timeIt([&] { fast.advance(gens); });
+    bool same       = slow.getGrid() == fast.getGrid() && slow.getStats().population == fast.getStats().population;
+    cout << fixed << setprecision(4) << gens << " generations: step() " << stepTime << " s, advance() " << advTime
+         << " s, identical: " << (same ? "yes" : "NO") << "\n";
+    if (!same)
+        return 1;
+
+    uint64_t reached = 0;
+    double jumpTime  = timeIt([&] { reached = fast.advance(jump); });
+    cout << "jump of " << jump << " generations: " << jumpTime << " s (reached generation "
+         << fast.getStats().generation << ", advanced " << reached << ")\n";
+    return 0;
+}
+
+// --------------------------------------------------------------
+// Suite: symmetric
+// For each symmetry group, seeds a symmetric soup, evolves it with
+// SymmetricLife (fundamental domain only) and with a full-board
+// ConwayLife, and checks the boards match. Then reports the time
+// and the cells stored/computed per step against symmetry=none.
+// --------------------------------------------------------------
+static int benchSymmetric(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    vector<Symmetry> groups = {Symmetry::None, Symmetry::C2, Symmetry::D2, Symmetry::D4};
+    if (rows == cols) {
+        groups.push_back(Symmetry::C4);
+        groups.push_back(Symmetry::D8);
+    }
+
+    cout << setw(8) << "symmetry" << setw(12) << "stored" << setw(12) << "computed" << setw(12) << "seconds"
+         << setw(10) << "speedup" << setw(12) << "identical" << "\n";
+
+    double baseline = 0;
+    bool allSame    = true;
+    for (Symmetry sym : groups) {
+        srand(params["seed"].get<int>());
+        ConwayLife full(rows, cols);
+        full.randomizeSymmetric(0.25, sym);
+
+        SymmetricLife engine(rows, cols, sym);
+        engine.load(full.getGrid());
+
+        double seconds = timeIt([&] {
+            for (int g = 0; g < gens; ++g) engine.step();
+        });
+        for (int g = 0; g < gens; ++g) full.step();
+
+        vector<vector<int>> board;
+        engine.expand(board);
+        bool same = board == full.getGrid() && engine.population() == full.getStats().population;
+        allSame   = allSame && same;
+
+        if (sym == Symmetry::None)
+            baseline = seconds;
+        cout << setw(8) << symmetryName(sym) << setw(12) << engine.storedCells() << setw(12)
+             << engine.computedCells() << setw(12) << fixed << setprecision(4) << seconds << setw(9)
+             << setprecision(2) << baseline / seconds << "x" << setw(12) << (same ? "yes" : "NO") << "\n";
+    }
+    return allSame ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: census
+// A batch soup search in miniature: 'soups' random soupSize x
+// soupSize soups are run for 'generations' generations on a rows x
+// cols board, then every board is censused by 'workers' threads.
+// The census runs twice, without and with a shared FateCache; the
+// object counts must match.
+// --------------------------------------------------------------
+static int benchCensus(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int workers  = params["workers"];
+    int soups    = params.value("soups", 200);
+    int soupSize = params.value("soupSize", 16);
+    LifeRule rule;
+
+    srand(params["seed"].get<int>());
+    vector<vector<vector<int>>> boards(soups, vector<vector<int>>(rows, vector<int>(cols, 0)));
+    for (auto& board : boards) {
+        for (int r = 0; r < soupSize; ++r)
+            for (int c = 0; c < soupSize; ++c) board[(rows - soupSize) / 2 + r][(cols - soupSize) / 2 + c] = rand() & 1;
+        BitBoard bits(rows, cols);
+        bits.load(board);
+        for (int g = 0; g < gens; ++g) bits.step(rule);
+        bits.store(board);
+    }
+
+    auto runCensus = [&](FateCache* cache, CensusResult& total) {
+        vector<CensusResult> partial(workers);
+        vector<thread> threads;
+        for (int w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w] {
+                for (int i = w; i < soups; i += workers) {
+                    CensusResult r = census(boards[i], rule, cache);
+                    for (auto& [name, n] : r.objects) partial[w].objects[name] += n;
+                    partial[w].clusters += r.clusters;
+                    partial[w].unsettled += r.unsettled;
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        for (auto& p : partial) {
+            for (auto& [name, n] : p.objects) total.objects[name] += n;
+            total.clusters += p.clusters;
+            total.unsettled += p.unsettled;
+        }
+    };
+
+    CensusResult plain, cached;
+    FateCache cache(params.value("cacheMB", 64) << 20);
+    double plainTime  = timeIt([&] { runCensus(nullptr, plain); });
+    double cachedTime = timeIt([&] { runCensus(&cache, cached); });
+    bool same         = plain.objects == cached.objects && plain.unsettled == cached.unsettled;
+
+    FateCacheStats st = cache.stats();
+    cout << fixed << setprecision(4) << soups << " soups, " << plain.clusters << " clusters (" << plain.unsettled
+         << " unsettled), " << workers << " threads\n"
+         << "census without cache: " << plainTime << " s\n"
+         << "census with cache:    " << cachedTime << " s (" << setprecision(2) << plainTime / cachedTime << "x)\n"
+         << "cache: " << st.entries << " entries, " << st.bytes / 1024.0 << " KiB, hit rate " << 100 * st.hitRate()
+         << "%, " << st.evictions << " evictions\n"
+         << "identical: " << (same ? "yes" : "NO") << "\n";
+
+    vector<pair<long, string>> common;
+    for (auto& [name, n] : cached.objects) common.push_back({n, name});
+    sort(common.rbegin(), common.rend());
+    for (size_t i = 0; i < common.size() && i < 10; ++i)
+        cout << setw(8) << common[i].first << "  " << common[i].second << "\n";
+    return same ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: heatmap
+// Times ConwayLife::step() with and without the age/activity
+// buffers, and checks both buffers against values kept by diffing
+// full grids (the thing the buffers replace).
+// --------------------------------------------------------------
+static int benchHeatmap(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+
+    srand(params["seed"].get<int>());
+    ConwayLife plain(rows, cols);
+    srand(params["seed"].get<int>());
+    ConwayLife mapped(rows, cols);
+    mapped.enableHeatmap(true);
+
+    double plainTime = timeIt([&] {
+        for (int g = 0; g < gens; ++g) plain.step();
+    });
+
+    vector<int> expectedAge((size_t)rows * cols), expectedHeat((size_t)rows * cols, 0);
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) expectedAge[(size_t)r * cols + c] = mapped.getGrid()[r][c];
+
+    double mappedTime = 0;
+    bool buffersMatch = true;
+    for (int g = 0; g < gens; ++g) {
+        vector<vector<int>> before = mapped.getGrid();
+        mappedTime += timeIt([&] { mapped.step(); });
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                size_t k     = (size_t)r * cols + c;
+                int alive    = mapped.getGrid()[r][c];
+                int& age     = expectedAge[k];
+                int& heat    = expectedHeat[k];
+                age          = alive ? min(age + 1, 255) : 0;
+                heat         = min(heat - heat / 8 + (alive != before[r][c]) * 64, 255);
+                buffersMatch = buffersMatch && mapped.getAge()[k] == age && mapped.getActivity()[k] == heat;
+            }
+        }
+    }
+
+    bool same = buffersMatch && plain.getGrid() == mapped.getGrid();
+    cout << fixed << setprecision(4) << gens << " generations: step() " << plainTime << " s, with heatmap "
+         << mappedTime << " s (" << showpos << setprecision(1) << 100 * (mappedTime / plainTime - 1) << noshowpos << "%), identical: "
+         << (same ? "yes" : "NO") << "\n";
+    return same ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: export
+// Runs 'generations' generations headless while a VideoExporter
+// records every 'every'-th one (lossless) into 'output' (default
+// /dev/null; "|cmd" pipes). Reports frames per second and how long
+// capture() held up the engine, and checks the byte count.
+// --------------------------------------------------------------
+static int benchExport(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    string output = params.value("output", "/dev/null");
+    auto format   = VideoExporter::parseFormat(params.value("format", "y4m"));
+    int scale = params.value("scale", 1), every = params.value("every", 1);
+
+    srand(params["seed"].get<int>());
+    ConwayLife life(rows, cols);
+
+    double slowest = 0, captureTime = 0;
+    RecorderStats st;
+    size_t frameBytes = 0, headerBytes = 0;
+    double total = timeIt([&] {
+        VideoExporter video(output, format, rows, cols, scale, Palette::mono(), 30, every, true);
+        headerBytes = video.stats().bytes;
+        frameBytes  = format == VideoExporter::Format::Y4M
+                          ? 6 + (size_t)video.width() * video.height() * 3 / 2
+                          : to_string(video.width()).size() + to_string(video.height()).size() + 9 +
+                               (size_t)video.width() * video.height() * 3;
+        for (int g = 0; g < gens; ++g) {
+            double t = timeIt([&] { video.capture(life.getGrid(), life.getStats().generation); });
+            slowest  = max(slowest, t);
+            captureTime += t;
+            life.step();
+        }
+        video.finish();
+        st = video.stats();
+    });
+
+    bool sizeOk = st.bytes == headerBytes + st.encoded * frameBytes && st.encoded == st.captured;
+    cout << fixed << setprecision(3) << st.encoded << " frames (" << st.dropped << " dropped), " << st.bytes / 1e6
+         << " MB in " << total << " s = " << st.encoded / total << " frames/s\n"
+         << "capture(): " << setprecision(1) << 1e6 * captureTime / gens << " us average, " << 1e6 * slowest
+         << " us worst\n"
+         << "byte count: " << (sizeOk ? "ok" : "WRONG") << "\n";
+    return sizeOk ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: gif
+// Records 'generations' generations into an animated GIF at
+// 'output' (lossless, so every frame is encoded) and reports the
+// time, the file size and the average bytes per frame.
+// --------------------------------------------------------------
+static int benchGif(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    string output = params.value("output", "/dev/null");
+    auto disposal = GifRecorder::parseDisposal(params.value("disposal", "keep"));
+    int scale     = params.value("scale", 1);
+
+    srand(params["seed"].get<int>());
+    ConwayLife life(rows, cols);
+
+    RecorderStats st;
+    double stepTime = 0;
+    double total    = timeIt([&] {
+        GifRecorder gif(output, rows, cols, scale, Palette::mono(), 2, 4, disposal, 1, true);
+        for (int g = 0; g < gens; ++g) {
+            gif.capture(life.getGrid(), life.getStats().generation);
+            stepTime += timeIt([&] { life.step(); });
+        }
+        gif.finish();
+        st = gif.stats();
+    });
+
+    cout << fixed << setprecision(3) << st.encoded << " frames in " << total << " s (" << stepTime
+         << " s of it stepping), " << st.bytes / 1024.0 << " KiB, " << setprecision(1)
+         << (double)st.bytes / max<uint64_t>(st.encoded, 1) << " bytes/frame\n";
+    return st.encoded == (uint64_t)gens ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: render
+// Renders 'generations' successive boards into an OffscreenScreen
+// and into a reference framebuffer drawn one cell rectangle at a
+// time (what SdlScreen does); the image hashes must match. Prints
+// throughput and the final golden hash.
+// --------------------------------------------------------------
+static int benchRender(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int cellSize = params.value("cellSize", 2);
+    int width = params.value("width", cols * cellSize), height = params.value("height", rows * cellSize);
+
+    srand(params["seed"].get<int>());
+    ConwayLife life(rows, cols);
+
+    vector<uint32_t> fast((size_t)width * height), slow((size_t)width * height);
+    OffscreenScreen screen(fast.data(), width, height, cellSize);
+    OffscreenScreen reference(slow.data(), width, height, cellSize);
+    const uint32_t black = OffscreenScreen::rgba(0, 0, 0), white = OffscreenScreen::rgba(255, 255, 255);
+
+    double spanTime = 0, rectTime = 0;
+    bool same       = true;
+    for (int g = 0; g < gens; ++g) {
+        spanTime += timeIt([&] { screen.render(life.getGrid()); });
+        rectTime += timeIt([&] {
+            fill(slow.begin(), slow.end(), black);
+            for (int r = 0; r < rows; ++r)
+                for (int c = 0; c < cols; ++c)
+                    if (life.getGrid()[r][c] == 1)
+                        for (int y = r * cellSize; y < min((r + 1) * cellSize, height); ++y)
+                            for (int x = c * cellSize; x < min((c + 1) * cellSize, width); ++x)
+                                slow[(size_t)y * width + x] = white;
+        });
+        same = same && screen.hash() == reference.hash();
+        life.step();
+    }
+
+    double mpx = (double)width * height * gens / 1e6;
+    cout << fixed << setprecision(1) << width << "x" << height << " pixels, " << gens << " frames\n"
+         << "span fill:     " << gens / spanTime << " frames/s (" << mpx / spanTime << " Mpx/s)\n"
+         << "per-cell rect: " << gens / rectTime << " frames/s (" << mpx / rectTime << " Mpx/s)\n"
+         << "golden hash: " << hex << screen.hash() << dec << ", identical: " << (same ? "yes" : "NO") << "\n";
+    return same ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: pacing
+// Runs 'generations' frames of step + offscreen render at fps=N,
+// first the old way (fixed sleep of one period after the work),
+// then under FrameScheduler, and prints the achieved rate and how
+// far frame intervals stray from the period. Fails if the
+// scheduler misses frames although the work fits the budget.
+// --------------------------------------------------------------
+static int benchPacing(const json& params) {
+    int rows = params["rows"], cols = params["cols"], frames = params["generations"];
+    double fps   = params.value("fps", 60.0);
+    int cellSize = params.value("cellSize", 2);
+
+    srand(params["seed"].get<int>());
+    ConwayLife life(rows, cols);
+    vector<uint32_t> pixels((size_t)cols * cellSize * rows * cellSize);
+    OffscreenScreen screen(pixels.data(), cols * cellSize, rows * cellSize, cellSize);
+    const double periodMs = 1000.0 / fps;
+
+    // Mean rate, mean and worst |interval - period| in ms.
+    auto report = [&](const char* name, const vector<double>& stamps) {
+        double dev = 0, worst = 0;
+        for (size_t i = 1; i < stamps.size(); ++i) {
+            double d = fabs(stamps[i] - stamps[i - 1] - periodMs);
+            dev += d;
+            worst = max(worst, d);
+        }
+        double span = stamps.back() - stamps.front();
+        cout << fixed << setprecision(2) << name << (stamps.size() - 1) * 1000.0 / span << " fps, jitter "
+             << dev / (stamps.size() - 1) << " ms avg, " << worst << " ms worst\n";
+    };
+    auto now = [] { return chrono::duration<double, milli>(chrono::steady_clock::now().time_since_epoch()).count(); };
+
+    double workMs = 0;
+    vector<double> stamps;
+    for (int f = 0; f <= frames; ++f) {
+        stamps.push_back(now());
+        workMs += timeIt([&] {
+            screen.render(life.getGrid());
+            life.step();
+        }) * 1000;
+        this_thread::sleep_for(chrono::duration<double, milli>(periodMs));
+    }
+    cout << fixed << setprecision(2) << "target " << fps << " fps, work " << workMs / (frames + 1) << " ms/frame\n";
+    report("fixed sleep: ", stamps);
+
+    FrameScheduler scheduler(fps);
+    stamps.clear();
+    for (int f = 0; f <= frames; ++f) {
+        stamps.push_back(now());
+        screen.render(life.getGrid());
+        scheduler.mark(FrameScheduler::Render);
+        life.step();
+        scheduler.mark(FrameScheduler::Update);
+        scheduler.wait();
+    }
+    report("scheduler:   ", stamps);
+    cout << scheduler.summary() << "\n";
+
+    bool fits = workMs / (frames + 1) < periodMs / 2;
+    return fits && scheduler.stats().missed > (uint64_t)frames / 20 ? 1 : 0;
+}
+
+// --------------------------------------------------------------
+// Suite: frameskip
+// Runs 'generations' paced frames of step + offscreen render at
+// fps=N, once drawing every frame in full and once under
+// RenderPolicy (reduced images drawn by a second framebuffer at
+// factor x cellSize). Prints the simulation rate each achieves and
+// how the frames were drawn.
+// --------------------------------------------------------------
+static int benchFrameSkip(const json& params) {
+    int rows = params["rows"], cols = params["cols"], frames = params["generations"];
+    double fps   = params.value("fps", 60.0);
+    int cellSize = params.value("cellSize", 4);
+    int width = cols * cellSize, height = rows * cellSize;
+
+    vector<uint32_t> pixels((size_t)width * height);
+    OffscreenScreen full(pixels.data(), width, height, cellSize);
+
+    auto run = [&](bool adaptive) {
+        srand(params["seed"].get<int>());
+        ConwayLife life(rows, cols);
+        FrameScheduler scheduler(fps);
+        RenderPolicy policy(scheduler.periodMs());
+        int drawn = 0;
+
+        double secs = timeIt([&] {
+            for (int f = 0; f < frames; ++f) {
+                auto d = adaptive ? policy.decide() : RenderPolicy::Decision::Present;
+                if (d == RenderPolicy::Decision::Present) {
+                    full.render(life.getGrid());
+                } else if (d == RenderPolicy::Decision::Reduced) {
+                    OffscreenScreen coarse(pixels.data(), width, height, cellSize * policy.factor());
+                    coarse.render(RenderPolicy::reduce(life.getGrid(), policy.factor(), rows, cols));
+                }
+                drawn += d != RenderPolicy::Decision::Skip;
+                if (d != RenderPolicy::Decision::Skip)
+                    policy.rendered(d == RenderPolicy::Decision::Present ? 1 : policy.factor(),
+                                    scheduler.mark(FrameScheduler::Render));
+                life.step();
+                policy.stepped(scheduler.mark(FrameScheduler::Update));
+                scheduler.wait();
+            }
+        });
+        cout << fixed << setprecision(1) << (adaptive ? "adaptive:    " : "always full: ") << frames / secs
+             << " gen/s (target " << fps << "), " << drawn / secs << " frames/s drawn, " << policy.framesSkipped()
+             << " skipped, " << policy.framesReduced() << " reduced\n";
+        return frames / secs;
+    };
+
+    run(false);
+    double rate = run(true);
+    return rate >= fps * 0.9 ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: views
+// Per frame, renders the main view (the visible width x height
+// window at cellSize) into an OffscreenScreen and steps, and every
+// 'every'-th frame refreshes a minimap of the whole board from a
+// DensityPyramid. Checks that every pyramid level adds up to the
+// population and prints the minimap's cost relative to the rest of
+// the frame.
+// --------------------------------------------------------------
+static int benchViews(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int width = params.value("width", 800), height = params.value("height", 600);
+    int cellSize = params.value("cellSize", 4), every = params.value("every", 4);
+    int mapWidth = params.value("mapWidth", 200), mapHeight = params.value("mapHeight", 150);
+
+    srand(params["seed"].get<int>());
+    ConwayLife life(rows, cols);
+    vector<uint32_t> pixels((size_t)width * height);
+    OffscreenScreen screen(pixels.data(), width, height, cellSize);
+
+    double cellsPerPixel = max((double)cols / mapWidth, (double)rows / mapHeight);
+    int level            = DensityPyramid::levelFor(cellsPerPixel);
+    DensityPyramid pyramid;
+    vector<uint8_t> shades;
+
+    double mainTime = 0, stepTime = 0, mapTime = 0;
+    bool sums       = true;
+    for (int g = 0; g < gens; ++g) {
+        mainTime += timeIt([&] { screen.render(life.getGrid()); });
+        if (g % every == 0) {
+            mapTime += timeIt([&] {
+                pyramid.build(life.getGrid());
+                pyramid.shade(level, 0, 0, pyramid.levelRows(level), pyramid.levelCols(level), shades);
+            });
+            for (int l = 1; l <= level; ++l) {
+                uint64_t total = 0;
+                for (uint32_t n : pyramid.level(l)) total += n;
+                sums = sums && total == (uint64_t)life.getStats().population;
+            }
+        }
+        stepTime += timeIt([&] { life.step(); });
+    }
+
+    cout << fixed << setprecision(3) << "step: " << 1000 * stepTime / gens << " ms/frame, main view " << width << "x" << height << ": " << 1000 * mainTime / gens
+         << " ms/frame\n"
+         << "minimap (level " << level << ", " << pyramid.levelCols(level) << "x" << pyramid.levelRows(level)
+         << " texels, every " << every << "): " << 1000 * mapTime / gens << " ms/frame, " << setprecision(1)
+         << 100 * mapTime / (mainTime + stepTime) << "% of step + main view\n"
+         << "pyramid sums match population: " << (sums ? "yes" : "NO") << "\n";
+    return sums ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: idle
+// 1. A board of blinkers and blocks (period 2): the detector must
+//    report period 2 within a few cycles, and its replayed boards
+//    must match the engine for the next 'generations' steps.
+// 2. A random soup: the cost of observe() per step relative to the
+//    step itself, and how soon (if ever) it settles.
+// --------------------------------------------------------------
+static int benchIdle(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int maxPeriod = params.value("maxPeriod", 8);
+
+    ConwayLife osc(rows, cols);
+    osc.clear();
+    for (int r = 2; r + 3 < rows; r += 8)
+        for (int c = 2; c + 3 < cols; c += 8) {
+            for (int d = 0; d < 3; ++d) osc.setCell(r, c + d, 1);  // blinker
+            for (int d = 0; d < 4; ++d) osc.setCell(r + 4 + d / 2, c + 4 + d % 2, 1);  // block
+        }
+    IdleDetector detector(maxPeriod);
+    int period = 0, steps = 0;
+    while (!period && steps < 100) {
+        osc.step();
+        ++steps;
+        period = detector.observe(osc.getGrid(), osc.getStats().generation);
+    }
+    bool replay = period == 2;
+    for (int g = 0; replay && g < gens; ++g) {
+        osc.step();
+        replay = detector.boardAt(osc.getStats().generation) == osc.getGrid();
+    }
+    cout << "oscillators: period " << period << " after " << steps << " steps, replay matches: "
+         << (replay ? "yes" : "NO") << "\n";
+
+    srand(params["seed"].get<int>());
+    ConwayLife soup(rows, cols);
+    IdleDetector soupDetector(maxPeriod);
+    double stepTime = 0, observeTime = 0;
+    int settled = 0;
+    for (int g = 0; g < gens && !settled; ++g) {
+        stepTime += timeIt([&] { soup.step(); });
+        observeTime += timeIt([&] { settled = soupDetector.observe(soup.getGrid(), soup.getStats().generation); });
+    }
+    cout << fixed << setprecision(1) << "soup: observe() costs " << 100 * observeTime / stepTime << "% of step(), "
+         << (settled ? "settled with period " + to_string(settled) + " at generation " +
+                           to_string(soupDetector.cycleStart())
+                     : "still active")
+         << " after " << soup.getStats().generation << " generations\n";
+    return replay ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: resize
+// A window being dragged larger: every frame the board grows by
+// one row and one column (CellularAutomaton::resize) and steps.
+// Reports the resize cost next to the step and next to copying
+// the board into a new one of the new size, how often rows had to
+// move, and checks that the old area kept its cells and that the
+// population stays right after shrinking back.
+// --------------------------------------------------------------
+static int benchResize(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+
+    srand(params["seed"].get<int>());
+    ConwayLife life(rows, cols);
+    double stepTime = 0, resizeTime = 0, copyTime = 0;
+    long moves = 0;
+    bool kept  = true;
+    for (int g = 0; g < gens; ++g) {
+        auto before = life.getGrid();
+        vector<const int*> data;
+        for (const auto& row : life.getGrid()) data.push_back(row.data());
+
+        resizeTime += timeIt([&] { life.resize(life.getRows() + 1, life.getCols() + 1); });
+        copyTime += timeIt([&] {
+            vector<vector<int>> copy(life.getRows(), vector<int>(life.getCols(), 0));
+            for (size_t r = 0; r < before.size(); ++r) std::copy(before[r].begin(), before[r].end(), copy[r].begin());
+        });
+
+        const auto& grid = life.getGrid();
+        for (size_t r = 0; r < before.size(); ++r) {
+            moves += grid[r].data() != data[r];
+            kept = kept && equal(before[r].begin(), before[r].end(), grid[r].begin()) && grid[r].back() == 0;
+        }
+        kept = kept && count(grid.back().begin(), grid.back().end(), 1) == 0;
+        stepTime += timeIt([&] { life.step(); });
+    }
+
+    life.resize(rows / 2, cols / 2);
+    long population = 0;
+    for (const auto& row : life.getGrid()) population += count(row.begin(), row.end(), 1);
+    bool counted = population == life.getStats().population;
+
+    cout << fixed << setprecision(3) << "grew " << rows << "x" << cols << " to " << rows + gens << "x" << cols + gens
+         << ": resize " << 1000 * resizeTime / gens << " ms/frame vs full copy " << 1000 * copyTime / gens
+         << " ms/frame, step " << 1000 * stepTime / gens << " ms/frame\n"
+         << "rows moved: " << moves << " of " << (long)gens * rows + (long)gens * (gens - 1) / 2 << "\n"
+         << "old cells kept: " << (kept ? "yes" : "NO") << ", population after shrink: " << (counted ? "yes" : "NO")
+         << "\n";
+    return kept && counted ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: gridview
+// A bit-packed engine (BitBoard) feeding a screen, a recorder's
+// capture path and the density pyramid, two ways: the old way,
+// store() into nested vectors first, and straight from view().
+// Both must produce the same image, pyramid and recorded frame.
+// --------------------------------------------------------------
+static int benchGridView(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int cellSize = params.value("cellSize", 2);
+    int width = cols * cellSize, height = rows * cellSize;
+
+    srand(params["seed"].get<int>());
+    ConwayLife life(rows, cols);
+    BitBoard board(rows, cols);
+    board.load(life.view());
+    LifeRule rule;
+
+    vector<uint32_t> a((size_t)width * height), b((size_t)width * height);
+    OffscreenScreen viaGrid(a.data(), width, height, cellSize), viaView(b.data(), width, height, cellSize);
+    DensityPyramid pa, pb;
+    vector<vector<int>> grid(rows, vector<int>(cols));
+    vector<uint8_t> fa((size_t)rows * cols), fb((size_t)rows * cols);
+
+    double copyTime = 0, viewTime = 0;
+    bool same       = true;
+    for (int g = 0; g < gens; ++g) {
+        auto consume = [&](const GridView& v, OffscreenScreen& screen, DensityPyramid& pyramid, vector<uint8_t>& frame) {
+            screen.render(v);
+            pyramid.build(v);
+            for (int r = 0; r < rows; ++r) v.rowAlive(r, 0, cols, &frame[(size_t)r * cols]);
+        };
+        copyTime += timeIt([&] {
+            board.store(grid);
+            consume(grid, viaGrid, pa, fa);
+        });
+        viewTime += timeIt([&] { consume(board.view(), viaView, pb, fb); });
+        same = same && viaGrid.hash() == viaView.hash() && pa.level(1) == pb.level(1) && fa == fb;
+        board.step(rule);
+    }
+
+    cout << fixed << setprecision(3) << rows << "x" << cols << " bit board, render + pyramid + capture per frame\n"
+         << "store() then nested grid: " << 1000 * copyTime / gens << " ms/frame\n"
+         << "BitBoard::view():         " << 1000 * viewTime / gens << " ms/frame\n"
+         << "identical output: " << (same ? "yes" : "NO") << "\n";
+    return same ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: engines
+// Many tiny boards ('boards' of rows x cols), each run for
+// 'generations': first one virtual step() call per generation
+// through CellularAutomaton*, then one Engine::run() per board for
+// every registered engine, observed every 'every' generations.
+// All must end with the same populations.
+// --------------------------------------------------------------
+static int benchEngines(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int boards = params.value("boards", 500), every = params.value("every", 0);
+
+    srand(params["seed"].get<int>());
+    vector<unique_ptr<CellularAutomaton>> soups;
+    for (int b = 0; b < boards; ++b) soups.push_back(make_unique<ConwayLife>(rows, cols));
+    vector<vector<vector<int>>> start;
+    for (auto& s : soups) start.push_back(s->getGrid());
+
+    vector<long> expected;
+    double virtualTime = timeIt([&] {
+        for (auto& s : soups) {
+            for (int g = 0; g < gens; ++g) s->step();
+            expected.push_back(s->getStats().population);
+        }
+    });
+    cout << fixed << setprecision(3) << boards << " boards of " << rows << "x" << cols << ", " << gens
+         << " generations\n"
+         << "virtual step():      " << 1000 * virtualTime << " ms\n";
+
+    bool same = true;
+    for (const auto& name : EngineRegistry::names()) {
+        auto engine     = EngineRegistry::create(name, rows, cols);
+        uint64_t frames = 0;
+        RunObserver observer{(uint64_t)every, [&](uint64_t, const GridView&) { return ++frames, true; }};
+        bool match  = true;
+        double time = timeIt([&] {
+            for (int b = 0; b < boards; ++b) {
+                engine->load(start[b]);
+                engine->run(gens, observer);
+                match = match && engine->population() == expected[b];
+            }
+        });
+        cout << name << string(max(0, 11 - (int)name.size()), ' ') << "run():  " << 1000 * time << " ms, "
+             << frames << " observations, populations match: " << (match ? "yes" : "NO") << "\n";
+        same = same && match;
+    }
+    return same ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: tiles
+// A lopsided board: a soup in the top-left 'region' x 'region'
+// cells, the rest empty. Steps it with ConwayLife (reference) and
+// with TiledLife on 1, 2, 4 ... 'workers' threads, and reports:
+//   - time and parallel efficiency (speedup / threads; only
+//     meaningful up to the cores this machine has)
+//   - active tiles per generation
+//   - load balance: mean / max tiles run per worker, for the work
+//     stealing scheduler and, for comparison, for static row bands
+//     over the same active tiles
+// Every TiledLife run must end on the reference board.
+// --------------------------------------------------------------
+static int benchTiles(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int workers = params["workers"], region = params.value("region", min(rows, cols) / 4);
+
+    srand(params["seed"].get<int>());
+    ConwayLife reference(rows, cols);
+    reference.clear();
+    for (int r = 0; r < region; ++r)
+        for (int c = 0; c < region; ++c) reference.setCell(r, c, rand() % 100 < 30);
+    const auto start = reference.getGrid();
+
+    double refTime = timeIt([&] {
+        for (int g = 0; g < gens; ++g) reference.step();
+    });
+    cout << fixed << setprecision(3) << rows << "x" << cols << ", soup in " << region << "x" << region << ", " << gens
+         << " generations, " << thread::hardware_concurrency() << " hardware threads\n"
+         << "ConwayLife::step():  " << 1000 * refTime / gens << " ms/gen\n";
+
+    bool same       = true;
+    double baseTime = 0;
+    for (int t = 1; t <= workers; t *= 2) {
+        TiledLife life(rows, cols, t);
+        life.restore(start, 0);
+        const int tileRows = (rows + CellularAutomaton::TILE - 1) / CellularAutomaton::TILE;
+        long activeSum = 0, bandMaxSum = 0;
+        vector<long> band(t);
+        double time = timeIt([&] {
+            for (int g = 0; g < gens; ++g) {
+                life.step();
+                activeSum += life.activeTiles();
+
+                // What static row bands (one per thread) would have got
+                fill(band.begin(), band.end(), 0);
+                for (int tile : life.activeList()) band[(long)(tile / (life.tileCount() / tileRows)) * t / tileRows]++;
+                bandMaxSum += *max_element(band.begin(), band.end());
+            }
+        });
+        if (t == 1)
+            baseTime = time;
+
+        auto st         = life.schedulerStats();
+        uint64_t maxRan = *max_element(st.perWorker.begin(), st.perWorker.end());
+        double stealBalance = maxRan ? (double)st.tasks / t / maxRan : 1;
+        double bandBalance  = bandMaxSum ? (double)activeSum / t / bandMaxSum : 1;
+
+        bool match = life.getGrid() == reference.getGrid() && life.getStats().population == reference.getStats().population;
+        same       = same && match;
+        cout << "TiledLife x" << t << ": " << setw(8) << 1000 * time / gens << " ms/gen, efficiency "
+             << setprecision(0) << 100 * baseTime / time / t << "%, " << setprecision(1)
+             << (double)activeSum / gens << " of " << life.tileCount() << " tiles active, balance "
+             << setprecision(0) << 100 * stealBalance << "% (static bands " << 100 * bandBalance << "%), "
+             << st.steals << " steals, " << (match ? "matches" : "DIFFERS") << setprecision(3) << "\n";
+    }
+    return same ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: numa
+// A soup over the whole board on 'workers' threads, stepped by
+// TiledLife as is (one thread allocated everything, tiles go to
+// whichever worker's slice they fall in) and in NUMA mode (owners
+// first-touch their rows and keep their tiles). 'affinity' pins the
+// workers (compact, scatter or a cpu list; default scatter in NUMA
+// mode). Reports where each worker ran and how many tiles ran on
+// their owner ("local"); the timings only differ on machines with
+// more than one node.
+// --------------------------------------------------------------
+static int benchNuma(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    int workers          = params["workers"];
+    json spec            = params.value("affinity", json("scatter"));
+    const string pinning = spec.is_string() ? spec.get<string>() : spec.dump();  // affinity=3 parses as a number
+
+    srand(params["seed"].get<int>());
+    ConwayLife start(rows, cols);
+    start.clear();
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) start.setCell(r, c, rand() % 100 < 30);
+
+    vector<vector<int>> result[2];
+    for (int numa = 0; numa <= 1; ++numa) {
+        TiledLife life(rows, cols, workers, numa, numa ? TileScheduler::parseAffinity(pinning, workers) : vector<int>());
+        life.restore(start.getGrid(), 0);
+        life.step();  // sets up (and in NUMA mode places) the buffers
+        auto before = life.schedulerStats();
+        double time = timeIt([&] {
+            for (int g = 1; g < gens; ++g) life.step();
+        });
+        auto after = life.schedulerStats();
+
+        uint64_t tasks = after.tasks - before.tasks, steals = after.steals - before.steals;
+        cout << fixed << setprecision(3) << (numa ? "NUMA mode: " : "plain:     ") << setw(8)
+             << 1000 * time / max(1, gens - 1) << " ms/gen, " << setprecision(1)
+             << (tasks ? 100.0 * (tasks - steals) / tasks : 100.0) << "% of tiles local, workers on";
+        for (int w = 0; w < workers; ++w) {
+            const auto& sched = life.getScheduler();
+            cout << " " << (sched.cpuOf(w) < 0 ? string("*") : to_string(sched.cpuOf(w))) << "/n" << sched.nodeOf(w);
+        }
+        cout << " (cpu/node)\n";
+        result[numa] = life.getGrid();
+    }
+    bool same = result[0] == result[1];
+    cout << (same ? "boards match" : "boards DIFFER") << "\n";
+
+    // Every tile row must be scheduled on the worker whose band
+    // first-touched it, including when the bands are uneven.
+    bool owned = true;
+    for (int tileRows : {1, 5, 7, 16, 33})
+        for (int threads = 1; threads <= 5; ++threads) {
+            TiledLife life(tileRows * CellularAutomaton::TILE - 3, CellularAutomaton::TILE, threads, true);
+            life.step();
+            vector<int> owner(tileRows, -1);
+            for (int w = 0; w < threads; ++w)
+                for (int tr = life.bandOf(w).first; tr < life.bandOf(w).second; ++tr) owner[tr] = w;
+            for (int tr = 0; tr < tileRows; ++tr) owned = owned && owner[tr] == life.ownerOfRow(tr);
+        }
+    cout << (owned ? "tile owners match their bands" : "tile owners DIFFER from their bands") << "\n";
+    return same && owned ? 0 : 1;
+}
+
+// --------------------------------------------------------------
+// Suite: hugepages
+// Steps one bit-packed soup with its buffers on each page size in
+// turn (off, thp, 2M, 1G), and reports what each request actually
+// got; sizes the system cannot provide fall back (see HugePages).
+// Use a big board (rows=16384 cols=16384 is 32 MB a buffer) for
+// the TLB to matter.
+// --------------------------------------------------------------
+static int benchHugePages(const json& params) {
+    int rows = params["rows"], cols = params["cols"], gens = params["generations"];
+    const HugePages::Size global = HugePages::requested();
+
+    srand(params["seed"].get<int>());
+    BitBoard soup(rows, cols);
+    for (int r = 0; r < rows; ++r) {
+        uint64_t* row = soup.row(r);
+        for (int w = 0; w < soup.wordsPerRow(); ++w) row[w] = (uint64_t)rand() << 33 ^ (uint64_t)rand() << 2 ^ rand();
+        if (cols % 64)
+            row[soup.wordsPerRow() - 1] &= (uint64_t(1) << (cols % 64)) - 1;
+    }
+    cout << fixed << setprecision(3) << rows << "x" << cols << ", " << gens << " generations\n";
+
+    bool same = true;
+    long expected = -1;
+    for (auto size : {HugePages::Size::Normal, HugePages::Size::Transparent, HugePages::Size::Huge2M,
+                      HugePages::Size::Huge1G}) {
+        HugePages::request(size);
+        BitBoard board(rows, cols);
+        board.load(soup.view());
+        double time = timeIt([&] {
+            for (int g = 0; g < gens; ++g) board.step(LifeRule());
+        });
+        long population = board.population();
+        if (expected < 0)
+            expected = population;
+        same = same && population == expected;
+        cout << setw(4) << HugePages::name(size) << ": " << setw(8) << 1000 * time / gens << " ms/gen, got "
+             << HugePages::name(HugePages::backing(board.row(0) - board.wordsPerRow())) << "  ["
+             << HugePages::report() << "]\n";
+    }
+    HugePages::request(global);
+    cout << (same ? "populations match" : "populations DIFFER") << "\n";
+    return same ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    json params = ArgsToJson(argc, argv);
+    for (auto& [key, value] : defaults.items()) {
+        if (params.find(key) == params.end()) {
+            params[key] = value;
+        }
+    }
+
+    map<string, function<int(const json&)>> suites = {
+        {"distributed", benchDistributed},
+        {"fastforward", benchFastForward},
+        {"symmetric", benchSymmetric},
+        {"census", benchCensus},
+        {"heatmap", benchHeatmap},
+        {"export", benchExport},
+        {"gif", benchGif},
+        {"render", benchRender},
+        {"pacing", benchPacing},
+        {"frameskip", benchFrameSkip},
+        {"views", benchViews},
+        {"idle", benchIdle},
+        {"resize", benchResize},
+        {"gridview", benchGridView},
+        {"engines", benchEngines},
+        {"tiles", benchTiles},
+        {"numa", benchNuma},
+        {"hugepages", benchHugePages},
+    };
+
+    string suite = params["suite"];
+    auto it      = suites.find(suite);
+    if (it == suites.end()) {
+        cerr << "Unknown suite '" << suite << "'. Available:";
+        for (auto& [name, fn] : suites) cerr << " " << name;
+        cerr << "\n";
+        return 2;
+    }
+
+    const json& pages = params["hugePages"];
+    HugePages::request(HugePages::parse(pages.is_string() ? pages.get<string>() : pages.dump()));
+
+    cout << "Benchmark parameters:\n" << params.dump(4) << endl;
+    int status = it->second(params);
+    cout << "Huge pages: " << HugePages::report() << endl;
+    return status;
+}
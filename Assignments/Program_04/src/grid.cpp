@@ -9,6 +9,7 @@
  *   - Converting grid coordinates to pixel coordinates
  *   - Drawing vertical & horizontal grid lines
  *   - Handling the basic SDL event loop
+ *   - Caching static drawing in a texture (GridLayer)
  *   - Using variables to control cell size, grid width, and height
  *
  *  Build Example (macOS Homebrew paths):
@@ -22,6 +23,7 @@
 #include <iostream>  // For error logging to std::cerr
 
 // #include "includes/sdl2_engine.hpp"  // Main SDL2 header
+#include "../includes/GridLayer.hpp"  // Cached background + grid lines
 #include "json.hpp"
 
 using json = nlohmann::json;
@@ -91,6 +93,16 @@ int main() {
         return 1;
     }
 
+    // ------------------------------------------------------------
+    // GRID LAYER
+    // ------------------------------------------------------------
+    // The background and the grid lines never change, so they are
+    // drawn once into a texture and that texture is copied each
+    // frame, instead of one SDL_RenderDrawLine call per line per
+    // frame. GridLayer rebuilds it only if the window or the cell
+    // size changes.
+    GridLayer gridLayer({30, 30, 40}, {80, 80, 100});
+
     // ------------------------------------------------------------
     // MAIN LOOP
     // ------------------------------------------------------------
@@ -113,32 +125,12 @@ int main() {
         }
 
         // --------------------------------------------------------
-        // CLEAR SCREEN
-        // --------------------------------------------------------
-        // Set the background color first (dark blue-gray here).
-        // The format is RGBA, each component 0–255.
-        SDL_SetRenderDrawColor(renderer, 30, 30, 40, 255);
-        SDL_RenderClear(renderer);
-
+        // BACKGROUND LAYER
         // --------------------------------------------------------
-        // DRAW GRID LINES
-        // --------------------------------------------------------
-        // Set the color for the grid lines (lighter gray).
-        SDL_SetRenderDrawColor(renderer, 80, 80, 100, 255);
-
-        // Draw vertical lines.
-        // Start at x = 0 and go to windowWidth, stepping by cellSize each time.
-        // SDL_RenderDrawLine(window to draw on, x1, y1, x2, y2)
-        for (int x = 0; x <= windowWidth; x += cellSize) {
-            SDL_RenderDrawLine(renderer, x, 0, x, windowHeight);
-        }
-
-        // Draw horizontal lines.
-        // Start at y = 0 and go to windowHeight, stepping by cellSize each time.
-        // SDL_RenderDrawLine(window to draw on, x1, y1, x2, y2)
-        for (int y = 0; y <= windowHeight; y += cellSize) {
-            SDL_RenderDrawLine(renderer, 0, y, windowWidth, y);
-        }
+        // Background color (dark blue-gray) and grid lines (lighter
+        // gray) in a single texture copy. Anything drawn after this
+        // (cells, overlays) lands on top of it.
+        gridLayer.draw(renderer, cellSize);
 
         // --------------------------------------------------------
         // SHOW THE RESULT
@@ -160,6 +152,8 @@ int main() {
     // CLEANUP
     // ------------------------------------------------------------
     // Free SDL resources before exiting to avoid memory leaks.
+    // The layer's texture belongs to the renderer, so it goes first.
+    gridLayer.invalidate();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
@@ -0,0 +1,73 @@
+// --------------------------------------------------------------
+// live_viewer.cpp
+// --------------------------------------------------------------
+// Terminal viewer that attaches to a running simulation's live
+// view (see LiveView.hpp) and redraws at its own pace.
+//
+// Usage:
+//   ./main liveView=/gol            (in one terminal)
+//   ./viewer name=/gol fps=10       (in any number of others)
+//
+// The viewer maps the segment read-only, so it can be started,
+// stopped, or killed at any time without affecting the engine.
+// --------------------------------------------------------------
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../includes/LiveView.hpp"
+#include "../includes/argsToJson.hpp"
+#include "../includes/json.hpp"
+
+using namespace std;
+using nlohmann::json;
+
+json defaults = {{"name", "/gol"}, {"fps", 10}};
+
+int main(int argc, char* argv[]) {
+    json params = ArgsToJson(argc, argv);
+    for (auto& [key, value] : defaults.items()) {
+        if (params.find(key) == params.end()) {
+            params[key] = value;
+        }
+    }
+
+    LiveViewReader reader(params["name"].get<string>());
+    int delayMs = 1000 / max(1, params["fps"].get<int>());
+
+    vector<vector<int>> grid;
+    uint64_t generation = 0, shown = UINT64_MAX;
+    bool reportedStale  = false;
+
+    while (true) {
+        bool fresh = reader.read(grid, generation);
+        if (reader.stalled() && !reportedStale) {
+            cerr << "live view is stale: the publisher stopped in the middle of a frame" << endl;
+        }
+        reportedStale = reader.stalled();
+        if (fresh && generation != shown) {
+            shown = generation;
+
+            // Clip to the terminal; each cell is two columns wide.
+            struct winsize w;
+            int maxRows = reader.rows(), maxCols = reader.cols();
+            if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0) {
+                maxRows = min(maxRows, w.ws_row - 2);
+                maxCols = min(maxCols, w.ws_col / 2);
+            }
+
+            string frame = "\033[H\033[2J";  // cursor home + clear
+            frame += "generation " + to_string(generation) + "\n";
+            for (int r = 0; r < maxRows; ++r) {
+                for (int c = 0; c < maxCols; ++c) frame += grid[r][c] ? "⬜" : "  ";
+                frame += "\n";
+            }
+            cout << frame << flush;
+        }
+        this_thread::sleep_for(chrono::milliseconds(delayMs));
+    }
+}